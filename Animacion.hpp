@@ -0,0 +1,84 @@
+// Animacion.hpp
+// Tiempo de las animaciones de la interfaz. RelojCuadros da los segundos
+// transcurridos desde el cuadro anterior y cada Interpolacion avanza con ese
+// tiempo, no con la cantidad de cuadros: las animaciones duran lo mismo a
+// 15, 60 o 144 cuadros por segundo, o con el redibujo por eventos.
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+
+class RelojCuadros {
+public:
+    // Una pausa larga (ventana arrastrada, depurador) cuenta como a lo sumo
+    // este tiempo, para no saltarse una animación entera de golpe
+    static constexpr float PASO_MAXIMO = 0.1f;
+
+    // Segundos desde la llamada anterior
+    float tick() {
+        return std::min(reloj.restart().asSeconds(), PASO_MAXIMO);
+    }
+
+private:
+    sf::Clock reloj;
+};
+
+enum class Curva {
+    Lineal,
+    SalidaSuave   // rápida al principio y frenando al final (cúbica)
+};
+
+class Interpolacion {
+public:
+    // Va de `desde` a `hasta` en `duracion` segundos
+    void iniciar(float desde, float hasta, float duracion, Curva curva = Curva::Lineal) {
+        inicio = desde;
+        fin = hasta;
+        this->duracion = duracion;
+        this->curva = curva;
+        transcurrido = 0.f;
+        repetir = false;
+        enCurso = true;
+    }
+
+    // Recorre de 0 a 1 cada `periodo` segundos hasta que se fije otro valor
+    void repetirCada(float periodo) {
+        iniciar(0.f, 1.f, periodo);
+        repetir = true;
+    }
+
+    // Queda quieta en `valor`
+    void fijar(float valor) {
+        inicio = fin = valor;
+        transcurrido = duracion = 0.f;
+        enCurso = false;
+    }
+
+    void avanzar(float dt) {
+        if (!enCurso) return;
+        transcurrido += dt;
+        if (repetir) {
+            transcurrido = std::fmod(transcurrido, duracion);
+        } else if (transcurrido >= duracion) {
+            transcurrido = duracion;
+            enCurso = false;
+        }
+    }
+
+    float valor() const {
+        float t = (duracion > 0.f) ? transcurrido / duracion : 1.f;
+        if (curva == Curva::SalidaSuave) t = 1.f - (1.f - t) * (1.f - t) * (1.f - t);
+        return inicio + (fin - inicio) * t;
+    }
+
+    bool activa() const { return enCurso; }
+
+private:
+    float inicio = 0.f;
+    float fin = 0.f;
+    float duracion = 0.f;
+    float transcurrido = 0.f;
+    Curva curva = Curva::Lineal;
+    bool repetir = false;
+    bool enCurso = false;
+};
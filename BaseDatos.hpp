@@ -0,0 +1,94 @@
+// BaseDatos.hpp
+// Base de posiciones resueltas que genera solver.cpp: el valor teórico de
+// cada posición de un tablero N x N con K en línea y, en el formato de 8
+// bits, en cuántas jugadas se llega al final jugando perfecto.
+//
+// Formato del archivo: una cabecera de 16 bytes y después una entrada por
+// cada código base 3 del tablero (casilla i = dígito i; 0 vacía, 1 X, 2 O).
+// Con 8 bits por posición cada byte es valor | distancia << 2; con 2 bits
+// (bases viejas, sin distancia) van cuatro valores por byte empezando por
+// los bits bajos. El archivo se proyecta en memoria recién en la primera
+// consulta, así que abrir el programa no cuesta nada y el sistema solo lee
+// las páginas que se consultan.
+#pragma once
+#include "ProyeccionArchivo.hpp"
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+// Valor desde el punto de vista del bando al que le toca
+enum class ValorBase : std::uint8_t {
+    Ilegal = 0,   // posición imposible o código fuera de la base
+    Gana = 1,
+    Empate = 2,
+    Pierde = 3
+};
+
+struct CabeceraBase {
+    char magia[8];                 // "GATOBD1" y un cero
+    std::uint8_t n = 0;
+    std::uint8_t k = 0;
+    std::uint8_t bitsPorPosicion = 8;   // 8: valor y distancia; 2: solo valor
+    std::uint8_t reservado = 0;
+    std::uint32_t posiciones = 0;  // 3^(n*n)
+};
+static_assert(sizeof(CabeceraBase) == 16, "la cabecera ocupa 16 bytes en disco");
+
+constexpr char MAGIA_BASE[8] = {'G', 'A', 'T', 'O', 'B', 'D', '1', '\0'};
+
+class BaseDatos {
+public:
+    explicit BaseDatos(std::string ruta) : ruta(std::move(ruta)) {}
+
+    BaseDatos(const BaseDatos&) = delete;
+    BaseDatos& operator=(const BaseDatos&) = delete;
+
+    // Proyecta el archivo si todavía no se hizo; false si no existe o no es válido
+    bool disponible() {
+        std::call_once(abierta, [this] { abrir(); });
+        return datos != nullptr;
+    }
+
+    // ¿Sirve para este tablero?
+    bool coincide(int n, int k) { return disponible() && cabecera.n == n && cabecera.k == k; }
+
+    ValorBase valor(std::uint32_t codigo) {
+        if (!disponible() || codigo >= cabecera.posiciones) return ValorBase::Ilegal;
+        if (cabecera.bitsPorPosicion == 8) return static_cast<ValorBase>(datos[sizeof(CabeceraBase) + codigo] & 3);
+        std::uint8_t byte = datos[sizeof(CabeceraBase) + codigo / 4];
+        return static_cast<ValorBase>((byte >> (2 * (codigo % 4))) & 3);
+    }
+
+    // Jugadas hasta el final con juego perfecto: ganando, lo antes posible;
+    // perdiendo, lo más tarde posible. -1 si la base no la guarda.
+    int distancia(std::uint32_t codigo) {
+        if (!disponible() || codigo >= cabecera.posiciones || cabecera.bitsPorPosicion != 8) return -1;
+        return datos[sizeof(CabeceraBase) + codigo] >> 2;
+    }
+
+    int n() { return disponible() ? cabecera.n : 0; }
+    int k() { return disponible() ? cabecera.k : 0; }
+
+private:
+    std::string ruta;
+    std::once_flag abierta;
+    CabeceraBase cabecera{};
+    ProyeccionArchivo archivo;
+    const std::uint8_t* datos = nullptr;
+
+    void abrir() {
+        if (!archivo.abrir(ruta)) return;
+        bool valida = archivo.tamano() >= sizeof(CabeceraBase);
+        if (valida) {
+            std::memcpy(&cabecera, archivo.datos(), sizeof(CabeceraBase));
+            std::size_t bytes = (cabecera.bitsPorPosicion == 8) ? std::size_t(cabecera.posiciones)
+                                                                 : (std::size_t(cabecera.posiciones) + 3) / 4;
+            valida = std::memcmp(cabecera.magia, MAGIA_BASE, sizeof(MAGIA_BASE)) == 0 &&
+                     (cabecera.bitsPorPosicion == 2 || cabecera.bitsPorPosicion == 8) &&
+                     archivo.tamano() >= sizeof(CabeceraBase) + bytes;
+        }
+        if (valida) datos = archivo.datos();
+        else archivo.cerrar();
+    }
+};
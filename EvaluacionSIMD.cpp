@@ -0,0 +1,147 @@
+// EvaluacionSIMD.cpp
+#include "EvaluacionSIMD.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GATO_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC y Clang compilan cada núcleo para su conjunto de instrucciones sin
+// pedirlo para todo el programa; MSVC acepta los intrínsecos sin más.
+#if defined(__GNUC__) || defined(__clang__)
+#define OBJETIVO(conjunto) __attribute__((target(conjunto)))
+#else
+#define OBJETIVO(conjunto)
+#endif
+
+namespace {
+
+// Posiciones [desde, hasta) con la evaluar() escalar
+void evaluarEscalar(const LotePosiciones& lote, std::int8_t* res, std::size_t desde, std::size_t hasta) {
+    for (std::size_t i = desde; i < hasta; i++)
+        res[i] = static_cast<std::int8_t>(evaluar(Bitboard{lote.x[i], lote.o[i]}));
+}
+
+#ifdef GATO_X86
+
+// Las líneas se recorren de la última a la primera y en cada una O pisa a X:
+// así gana la primera línea completa, con O antes que X, como en evaluar().
+
+OBJETIVO("sse4.1")
+std::size_t evaluarSSE4(const LotePosiciones& lote, std::int8_t* res) {
+    const __m128i diez = _mm_set1_epi16(10);
+    const __m128i menosDiez = _mm_set1_epi16(-10);
+    std::size_t n = lote.size() / 16 * 16;
+    for (std::size_t i = 0; i < n; i += 16) {
+        __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lote.x[i]));
+        __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lote.x[i + 8]));
+        __m128i o0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lote.o[i]));
+        __m128i o1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lote.o[i + 8]));
+        __m128i r0 = _mm_setzero_si128();
+        __m128i r1 = _mm_setzero_si128();
+        for (int l = static_cast<int>(LINEAS_GANADORAS.size()) - 1; l >= 0; l--) {
+            __m128i linea = _mm_set1_epi16(static_cast<short>(LINEAS_GANADORAS[l]));
+            r0 = _mm_blendv_epi8(r0, menosDiez, _mm_cmpeq_epi16(_mm_and_si128(x0, linea), linea));
+            r1 = _mm_blendv_epi8(r1, menosDiez, _mm_cmpeq_epi16(_mm_and_si128(x1, linea), linea));
+            r0 = _mm_blendv_epi8(r0, diez, _mm_cmpeq_epi16(_mm_and_si128(o0, linea), linea));
+            r1 = _mm_blendv_epi8(r1, diez, _mm_cmpeq_epi16(_mm_and_si128(o1, linea), linea));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(res + i), _mm_packs_epi16(r0, r1));
+    }
+    return n;
+}
+
+OBJETIVO("avx2")
+std::size_t evaluarAVX2(const LotePosiciones& lote, std::int8_t* res) {
+    const __m256i diez = _mm256_set1_epi16(10);
+    const __m256i menosDiez = _mm256_set1_epi16(-10);
+    std::size_t n = lote.size() / 32 * 32;
+    for (std::size_t i = 0; i < n; i += 32) {
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&lote.x[i]));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&lote.x[i + 16]));
+        __m256i o0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&lote.o[i]));
+        __m256i o1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&lote.o[i + 16]));
+        __m256i r0 = _mm256_setzero_si256();
+        __m256i r1 = _mm256_setzero_si256();
+        for (int l = static_cast<int>(LINEAS_GANADORAS.size()) - 1; l >= 0; l--) {
+            __m256i linea = _mm256_set1_epi16(static_cast<short>(LINEAS_GANADORAS[l]));
+            r0 = _mm256_blendv_epi8(r0, menosDiez, _mm256_cmpeq_epi16(_mm256_and_si256(x0, linea), linea));
+            r1 = _mm256_blendv_epi8(r1, menosDiez, _mm256_cmpeq_epi16(_mm256_and_si256(x1, linea), linea));
+            r0 = _mm256_blendv_epi8(r0, diez, _mm256_cmpeq_epi16(_mm256_and_si256(o0, linea), linea));
+            r1 = _mm256_blendv_epi8(r1, diez, _mm256_cmpeq_epi16(_mm256_and_si256(o1, linea), linea));
+        }
+        // packs intercala por mitades de 128 bits; permute devuelve el orden
+        __m256i empaquetado = _mm256_permute4x64_epi64(_mm256_packs_epi16(r0, r1), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), empaquetado);
+    }
+    return n;
+}
+
+bool cpuSoporta(NucleoSIMD nucleo) {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    int maximo = info[0];
+    if (nucleo == NucleoSIMD::SSE4) {
+        __cpuid(info, 1);
+        return (info[2] & (1 << 19)) != 0;
+    }
+    if (maximo < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 6) != 6) return false;   // el SO guarda los registros YMM
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    if (nucleo == NucleoSIMD::SSE4) return __builtin_cpu_supports("sse4.1");
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif  // GATO_X86
+
+NucleoSIMD detectarNucleo() {
+#ifdef GATO_X86
+    if (cpuSoporta(NucleoSIMD::AVX2)) return NucleoSIMD::AVX2;
+    if (cpuSoporta(NucleoSIMD::SSE4)) return NucleoSIMD::SSE4;
+#endif
+    return NucleoSIMD::Escalar;
+}
+
+}  // namespace
+
+NucleoSIMD nucleoDisponible() {
+    static const NucleoSIMD nucleo = detectarNucleo();
+    return nucleo;
+}
+
+const char* nombreNucleo(NucleoSIMD nucleo) {
+    switch (nucleo) {
+        case NucleoSIMD::Escalar: return "escalar";
+        case NucleoSIMD::SSE4: return "SSE4.1";
+        case NucleoSIMD::AVX2: return "AVX2";
+    }
+    return "?";
+}
+
+void evaluarLote(const LotePosiciones& lote, std::vector<std::int8_t>& resultados) {
+    evaluarLote(lote, resultados, nucleoDisponible());
+}
+
+void evaluarLote(const LotePosiciones& lote, std::vector<std::int8_t>& resultados, NucleoSIMD nucleo) {
+    resultados.resize(lote.size());
+    // los núcleos están ordenados de menor a mayor: se recorta al disponible
+    if (static_cast<int>(nucleo) > static_cast<int>(nucleoDisponible())) nucleo = nucleoDisponible();
+
+    std::size_t hechas = 0;
+#ifdef GATO_X86
+    if (nucleo == NucleoSIMD::AVX2) hechas = evaluarAVX2(lote, resultados.data());
+    else if (nucleo == NucleoSIMD::SSE4) hechas = evaluarSSE4(lote, resultados.data());
+#endif
+    // la cola que no llena un registro (o todo, sin SIMD)
+    evaluarEscalar(lote, resultados.data(), hechas, lote.size());
+}
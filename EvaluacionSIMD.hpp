@@ -0,0 +1,46 @@
+// EvaluacionSIMD.hpp
+// evaluar() en lote: muchas posiciones independientes a la vez con AVX2
+// (16 por registro) o SSE4.1 (8 por registro), con versión escalar de
+// respaldo. El núcleo se elige en tiempo de ejecución según la CPU.
+#pragma once
+#include "IA.hpp"
+#include <cstdint>
+#include <vector>
+
+enum class NucleoSIMD {
+    Escalar,
+    SSE4,
+    AVX2
+};
+
+// Posiciones como estructura de arreglos: todas las máscaras de X juntas y
+// todas las de O juntas, para cargarlas de a 8 o 16 en un registro.
+struct LotePosiciones {
+    std::vector<std::uint16_t> x;
+    std::vector<std::uint16_t> o;
+
+    void agregar(const Bitboard& b) {
+        x.push_back(b.x);
+        o.push_back(b.o);
+    }
+    void reservar(std::size_t n) {
+        x.reserve(n);
+        o.reserve(n);
+    }
+    void limpiar() {
+        x.clear();
+        o.clear();
+    }
+    std::size_t size() const { return x.size(); }
+};
+
+// El mejor núcleo que soporta esta CPU
+NucleoSIMD nucleoDisponible();
+const char* nombreNucleo(NucleoSIMD nucleo);
+
+// resultados[i] = evaluar(posición i): 10, -10 o 0, exactamente igual que la
+// versión escalar (incluido el orden de las líneas en tableros con las dos
+// líneas). Sin núcleo usa el mejor disponible; uno que la CPU no soporta
+// cae al mejor disponible.
+void evaluarLote(const LotePosiciones& lote, std::vector<std::int8_t>& resultados);
+void evaluarLote(const LotePosiciones& lote, std::vector<std::int8_t>& resultados, NucleoSIMD nucleo);
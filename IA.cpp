@@ -1,187 +1,372 @@
 // IA.cpp
 #include "IA.hpp"
-#include <vector>
-#include <limits>
-#include <cstdlib>
-
-std::vector<std::pair<int,int>> movimientosDisponibles() {
-    std::vector<std::pair<int,int>> moves;
-    for (int r=0;r<3;r++)
-        for (int c=0;c<3;c++)
-            if (board[r][c] == ' ')
-                moves.push_back({r, c});
+#include <algorithm>
+#include <bit>
+
+// Orden de exploración: centro, esquinas y luego lados.
+// Las casillas más fuertes primero hacen que la poda alfa-beta corte antes.
+constexpr std::array<int, 9> ORDEN_CASILLAS = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+
+ListaMovimientos movimientosDisponibles(const Bitboard& b) {
+    ListaMovimientos moves;
+    for (int casilla : ORDEN_CASILLAS)
+        if (b.libres() & (1u << casilla))
+            moves.agregar(casilla);
     return moves;
 }
 
+int evaluar(const Bitboard& b) {
+    for (std::uint16_t linea : LINEAS_GANADORAS) {
+        if ((b.o & linea) == linea) return 10;
+        if ((b.x & linea) == linea) return -10;
+    }
+    return 0;
+}
+
+bool tableroLleno(const Bitboard& b) {
+    return b.ocupadas() == TABLERO_COMPLETO;
+}
+
 // =========================
 // IA Fácil
 // =========================
-void cpuEasy() {
-    auto movs = movimientosDisponibles();
-    if (movs.empty()) return;
+int cpuEasy(const Bitboard& b, ContextoIA& ctx) {
+    auto movs = movimientosDisponibles(b);
+    if (movs.empty()) return -1;
 
-    int idx = rand() % movs.size();
-    board[movs[idx].first][movs[idx].second] = 'O';
+    return movs[ctx.rng() % movs.size()];
 }
 
 // =========================
 // IA Media (heurística)
 // =========================
-bool intentaGanarOBloquear(char simbolo) {
-    for (auto [r, c] : movimientosDisponibles()) {
-        board[r][c] = simbolo;
-        // comprobar si ganaría
-        bool gana = false;
-
-        // filas
-        for (int i=0;i<3;i++)
-            if (board[i][0]==simbolo && board[i][1]==simbolo && board[i][2]==simbolo)
-                gana = true;
-
-        // columnas
-        for (int i=0;i<3;i++)
-            if (board[0][i]==simbolo && board[1][i]==simbolo && board[2][i]==simbolo)
-                gana = true;
-
-        // diagonales
-        if (board[0][0]==simbolo && board[1][1]==simbolo && board[2][2]==simbolo) gana = true;
-        if (board[0][2]==simbolo && board[1][1]==simbolo && board[2][0]==simbolo) gana = true;
-
-          // --------------------------------------
-        // CASO 1: IA intenta ganar (simbolo == 'O')
-        // --------------------------------------
-        if (gana && simbolo == 'O') {
-            return true;  // deja la O colocada
-        }
-
-        // --------------------------------------
-        // CASO 2: IA intenta bloquear (simbolo == 'X')
-        // --------------------------------------
-        if (gana && simbolo == 'X') {
-            board[r][c] = 'O';  // coloca la O para bloquear
-            return true;
-        }
-
-        board[r][c] = ' '; // revertir
+// Devuelve la casilla libre que completa una línea para la máscara dada, o -1.
+// Con las fichas propias sirve para ganar; con las del rival, para bloquear.
+int intentaGanarOBloquear(const Bitboard& b, std::uint16_t fichas) {
+    for (int casilla : movimientosDisponibles(b)) {
+        // comprobar si ganaría: basta con mirar las líneas que pasan por la casilla
+        std::uint16_t conJugada = fichas | (1u << casilla);
+        for (std::uint16_t linea : LINEAS_GANADORAS)
+            if ((linea & (1u << casilla)) && (conJugada & linea) == linea)
+                return casilla;
     }
-    return false;
+    return -1;
 }
 
-void cpuMedium() {
+int cpuMedium(const Bitboard& b, ContextoIA& ctx) {
+    bool soyO = (b.turno() == 'O');
+
     // 1. ganar si puede
-    if (intentaGanarOBloquear('O')) return;
+    int casilla = intentaGanarOBloquear(b, soyO ? b.o : b.x);
+    if (casilla >= 0) return casilla;
 
-    // 2. bloquear si el jugador va a ganar
-    if (intentaGanarOBloquear('X')) return;
+    // 2. bloquear si el rival va a ganar
+    casilla = intentaGanarOBloquear(b, soyO ? b.x : b.o);
+    if (casilla >= 0) return casilla;
 
     // 3. tomar centro
-    if (board[1][1] == ' ') {
-        board[1][1] = 'O';
-        return;
-    }
+    if (b.get(1, 1) == ' ') return 4;
 
     // 4. esquinas
-    std::vector<std::pair<int,int>> esquinas = {{0,0},{0,2},{2,0},{2,2}};
-    for (auto [r,c] : esquinas) {
-        if (board[r][c] == ' ') {
-            board[r][c] = 'O';
-            return;
-        }
-    }
+    constexpr int esquinas[] = {0, 2, 6, 8};
+    for (int esquina : esquinas)
+        if (b.libres() & (1u << esquina)) return esquina;
 
     // 5. movimiento aleatorio
-    cpuEasy();
+    return cpuEasy(b, ctx);
 }
 
 // =========================
-// IA Difícil (Minimax)
+// Tabla de transposición
 // =========================
+// Las posiciones equivalentes por rotación o reflexión tienen el mismo valor,
+// así que se guardan bajo su forma canónica: la menor de las 8 variantes.
 
-int evaluar() {
-    // X gana = -10, O gana = 10
-    for (int i=0;i<3;i++) {
-        if (board[i][0]==board[i][1] && board[i][1]==board[i][2] && board[i][0] != ' ') {
-            return (board[i][0] == 'O') ? 10 : -10;
-        }
-        if (board[0][i]==board[1][i] && board[1][i]==board[2][i] && board[0][i] != ' ') {
-            return (board[0][i] == 'O') ? 10 : -10;
-        }
+// casilla destino de (r, c) en cada una de las 8 simetrías del tablero
+constexpr int casillaSimetrica(int simetria, int r, int c) {
+    switch (simetria) {
+        case 0: return r * 3 + c;              // identidad
+        case 1: return c * 3 + (2 - r);        // rotación 90
+        case 2: return (2 - r) * 3 + (2 - c);  // rotación 180
+        case 3: return (2 - c) * 3 + r;        // rotación 270
+        case 4: return r * 3 + (2 - c);        // espejo horizontal
+        case 5: return (2 - r) * 3 + c;        // espejo vertical
+        case 6: return c * 3 + r;              // diagonal principal
+        default: return (2 - c) * 3 + (2 - r); // diagonal secundaria
     }
+}
 
-    if (board[0][0]==board[1][1] && board[1][1]==board[2][2] && board[0][0] != ' ')
-        return (board[0][0]=='O') ? 10 : -10;
+constexpr std::array<std::array<std::uint16_t, 512>, 8> generarSimetrias() {
+    std::array<std::array<std::uint16_t, 512>, 8> t{};
+    for (int s = 0; s < 8; s++)
+        for (int m = 0; m < 512; m++)
+            for (int i = 0; i < 9; i++)
+                if (m & (1 << i)) t[s][m] |= 1u << casillaSimetrica(s, i / 3, i % 3);
+    return t;
+}
+constexpr std::array<std::array<std::uint16_t, 512>, 8> SIMETRIAS = generarSimetrias();
 
-    if (board[0][2]==board[1][1] && board[1][1]==board[2][0] && board[0][2] != ' ')
-        return (board[0][2]=='O') ? 10 : -10;
+constexpr std::uint32_t claveCanonica(const Bitboard& b) {
+    std::uint32_t clave = (std::uint32_t(b.x) << 9) | b.o;
+    for (int s = 1; s < 8; s++)
+        clave = std::min(clave, (std::uint32_t(SIMETRIAS[s][b.x]) << 9) | SIMETRIAS[s][b.o]);
+    return clave;
+}
 
-    return 0;
+EntradaTT& entradaTT(TablaTransposicion& tt, std::uint32_t clave) {
+    return tt.entradas[(clave * 0x9E3779B1u) >> (32 - TablaTransposicion::BITS)];
 }
 
-bool tableroLleno() {
-    for (auto &row : board)
-        for (char c : row)
-            if (c == ' ') return false;
-    return true;
+// Los valores de victoria dependen de la distancia; en la tabla se guardan
+// medidos desde el propio nodo para que sirvan a cualquier profundidad.
+int aTT(int valor, int profundidad) {
+    return valor > 0 ? valor + profundidad : valor < 0 ? valor - profundidad : 0;
 }
+int desdeTT(int valor, int profundidad) {
+    return valor > 0 ? valor - profundidad : valor < 0 ? valor + profundidad : 0;
+}
+
+// =========================
+// IA Difícil (Minimax)
+// =========================
 
-int minimax(bool isMax) {
-    int score = evaluar();
+// Puntajes ajustados por profundidad: ganar en menos jugadas vale más
+// (10 - profundidad) y perder más tarde cuesta menos (profundidad - 10).
+// Las jugadas se hacen y deshacen sobre el tablero incremental: el fin de
+// partida se lee de sus cuentas en lugar de recorrer las 8 líneas por nodo.
+int minimax(TableroIncremental& t, int profundidad, int alfa, int beta, bool isMax, ContextoIA& ctx) {
+    ctx.nodos++;
+    int score = t.valor();
 
-    if (score == 10 || score == -10) return score;
-    if (tableroLleno()) return 0;
+    if (score == 10) return score - profundidad;
+    if (score == -10) return score + profundidad;
+    if (t.lleno()) return 0;
 
+    std::uint32_t clave = claveCanonica(t.b) + 1;
+    EntradaTT& entrada = entradaTT(ctx.tt, clave);
+    if (entrada.clave == clave) {
+        ctx.tt.stats.aciertos++;
+        int v = desdeTT(entrada.valor, profundidad);
+        if (entrada.cota == Cota::Exacto) return v;
+        if (entrada.cota == Cota::Inferior && v >= beta) return v;
+        if (entrada.cota == Cota::Superior && v <= alfa) return v;
+    } else {
+        ctx.tt.stats.fallos++;
+    }
+    int alfaOriginal = alfa, betaOriginal = beta;
+
+    int best;
     if (isMax) {
-        int best = -1000;
-        for (auto [r,c] : movimientosDisponibles()) {
-            board[r][c] = 'O';
-            best = std::max(best, minimax(false));
-            board[r][c] = ' ';
+        best = -1000;
+        for (int casilla : movimientosDisponibles(t.b)) {
+            t.colocar(casilla);
+            best = std::max(best, minimax(t, profundidad + 1, alfa, beta, false, ctx));
+            t.quitar(casilla);
+            alfa = std::max(alfa, best);
+            if (alfa >= beta) break;   // X nunca permitiría llegar aquí
         }
-        return best;
     } else {
-        int best = 1000;
-        for (auto [r,c] : movimientosDisponibles()) {
-            board[r][c] = 'X';
-            best = std::min(best, minimax(true));
-            board[r][c] = ' ';
+        best = 1000;
+        for (int casilla : movimientosDisponibles(t.b)) {
+            t.colocar(casilla);
+            best = std::min(best, minimax(t, profundidad + 1, alfa, beta, true, ctx));
+            t.quitar(casilla);
+            beta = std::min(beta, best);
+            if (alfa >= beta) break;   // O ya tiene algo mejor en otra rama
         }
-        return best;
     }
+
+    entrada.clave = clave;
+    entrada.valor = static_cast<std::int8_t>(aTT(best, profundidad));
+    entrada.cota = (best <= alfaOriginal) ? Cota::Superior
+                 : (best >= betaOriginal) ? Cota::Inferior
+                 : Cota::Exacto;
+    ctx.tt.stats.guardados++;
+    return best;
+}
+
+void perft(TableroIncremental& t, ResultadoPerft& r) {
+    r.nodos++;
+    if (t.linea >= 0) {
+        r.partidas++;
+        (t.ganador() == 'X' ? r.ganaX : r.ganaO)++;
+        return;
+    }
+    if (t.lleno()) {
+        r.partidas++;
+        r.empates++;
+        return;
+    }
+    for (int casilla : movimientosDisponibles(t.b)) {
+        t.colocar(casilla);
+        perft(t, r);
+        t.quitar(casilla);
+    }
+}
+
+// Búsqueda completa en tiempo de ejecución para el bando al que le toca.
+// La dificultad Difícil ya no la usa (ver tabla perfecta abajo), pero sigue
+// siendo el motor de búsqueda.
+int buscarJugada(const Bitboard& tablero, ContextoIA& ctx) {
+    int valor;
+    return buscarJugada(tablero, ctx, valor);
 }
 
-void cpuHard() {
-    int bestVal = -1000;
-    int bestR = -1, bestC = -1;
+// La primera jugada se busca con ventana completa y las demás solo cuando
+// mejoran, así que bestVal termina siendo el valor exacto de la raíz.
+int buscarJugada(const Bitboard& tablero, ContextoIA& ctx, int& valor) {
+    TableroIncremental t(tablero);
+    char yo = t.turno();
+    int bestVal = (yo == 'O') ? -1000 : 1000;
+    int bestCasilla = -1;
 
-    for (auto [r,c] : movimientosDisponibles()) {
-        board[r][c] = 'O';
-        int moveVal = minimax(false);
-        board[r][c] = ' ';
+    for (int casilla : movimientosDisponibles(t.b)) {
+        t.colocar(casilla);
+        // basta con la ventana que mejora lo ya visto: (bestVal, 1000) para O,
+        // (-1000, bestVal) para X
+        int moveVal = (yo == 'O') ? minimax(t, 1, bestVal, 1000, false, ctx)
+                                  : minimax(t, 1, -1000, bestVal, true, ctx);
+        t.quitar(casilla);
 
-        if (moveVal > bestVal) {
+        if ((yo == 'O') ? moveVal > bestVal : moveVal < bestVal) {
             bestVal = moveVal;
-            bestR = r;
-            bestC = c;
+            bestCasilla = casilla;
         }
     }
+    valor = bestVal;
+    return bestCasilla;
+}
+
+// =========================
+// Tabla de juego perfecto (generada en compilación)
+// =========================
+// Cada tablero se indexa por su código base 3 (codigoTablero(), IA.hpp).
+// Para cada uno se guarda la mejor jugada del bando al que le toca, 4 bits
+// por posición (0xF = sin jugada), y su valor exacto.
+
+constexpr int SIN_JUGADA = 0xF;
 
-    if (bestR != -1)
-        board[bestR][bestC] = 'O';
+// Al poner una ficha en la casilla i el código crece en 3^i o 2*3^i, así que
+// todos los hijos tienen código mayor: recorriendo de mayor a menor cada
+// posición se resuelve con los valores ya calculados de sus hijos.
+// Los valores son como los de minimax: 10 - distancia si gana O,
+// distancia - 10 si gana X, 0 empate.
+struct TablaPerfecta {
+    std::array<std::uint8_t, (CODIGOS_TABLERO + 1) / 2> jugadas{};
+    std::array<std::int8_t, CODIGOS_TABLERO> valor{};
+};
+
+constexpr TablaPerfecta generarTablaPerfecta() {
+    TablaPerfecta tabla;
+    auto& valor = tabla.valor;
+    auto& jugadas = tabla.jugadas;
+
+    for (int codigo = CODIGOS_TABLERO - 1; codigo >= 0; codigo--) {
+        Bitboard b = tableroDeCodigo(codigo);
+
+        int jugada = SIN_JUGADA;
+        int fichasX = std::popcount(b.x), fichasO = std::popcount(b.o);
+        bool turnoO = (fichasX == fichasO + 1);
+
+        if (tieneLinea(b.o)) valor[codigo] = 10;
+        else if (tieneLinea(b.x)) valor[codigo] = -10;
+        else if (b.ocupadas() == TABLERO_COMPLETO) valor[codigo] = 0;
+        else if (turnoO || fichasX == fichasO) {
+            int mejor = turnoO ? -1000 : 1000;
+            for (int casilla : ORDEN_CASILLAS) {
+                if (!(b.libres() & (1u << casilla))) continue;
+                int v = valor[codigo + (turnoO ? 2 : 1) * POTENCIAS_3[casilla]];
+                v = (v > 0) ? v - 1 : (v < 0) ? v + 1 : 0;   // una jugada más lejos
+                if (turnoO ? v > mejor : v < mejor) {
+                    mejor = v;
+                    jugada = casilla;
+                }
+            }
+            valor[codigo] = static_cast<std::int8_t>(mejor);
+        }
+
+        jugadas[codigo / 2] |= static_cast<std::uint8_t>(jugada << (4 * (codigo % 2)));
+    }
+    return tabla;
+}
+
+constexpr TablaPerfecta TABLA_PERFECTA = generarTablaPerfecta();
+
+constexpr int jugadaPerfecta(const Bitboard& b) {
+    int codigo = codigoTablero(b);
+    return (TABLA_PERFECTA.jugadas[codigo / 2] >> (4 * (codigo % 2))) & 0xF;
+}
+
+// comprobaciones en compilación: empate perfecto, X abre al centro, O gana y O bloquea
+static_assert(TABLA_PERFECTA.valor[0] == 0);
+static_assert(codigoTablero(tableroDeCodigo(CODIGOS_TABLERO - 1)) == CODIGOS_TABLERO - 1);
+static_assert(jugadaPerfecta(Bitboard{}) == 4);
+static_assert(jugadaPerfecta(Bitboard{0x0B0, 0x003}) == 2);
+static_assert(jugadaPerfecta(Bitboard{0x003, 0x010}) == 2);
+
+int valorPerfecto(const Bitboard& b) {
+    return TABLA_PERFECTA.valor[codigoTablero(b)];
+}
+
+int cpuHard(const Bitboard& b) {
+    int casilla = jugadaPerfecta(b);
+    return (casilla != SIN_JUGADA) ? casilla : -1;
+}
+
+// Monte Carlo sobre el mismo tablero 3x3 (K = 3)
+int cpuMCTS(const Bitboard& b, ContextoIA& ctx) {
+    std::array<std::uint8_t, 9> celdas{};
+    for (int i = 0; i < 9; i++) {
+        if (b.x & (1u << i)) celdas[i] = 1;
+        else if (b.o & (1u << i)) celdas[i] = 2;
+    }
+    ctx.ultimoMCTS = MCTSNxN<3, 3>::buscar(celdas, ctx.mcts, (std::uint64_t(ctx.rng()) << 32) | ctx.rng());
+    return ctx.ultimoMCTS.casilla;
 }
 
 // =========================
 // Selector de dificultad
 // =========================
-void cpuMakeMove(Difficulty diff) {
+int elegirMovimiento(Bitboard tablero, Difficulty diff, ContextoIA& ctx) {
     switch (diff) {
         case Difficulty::Easy:
-            cpuEasy();
-            break;
+            return cpuEasy(tablero, ctx);
         case Difficulty::Medium:
-            cpuMedium();
-            break;
+            return cpuMedium(tablero, ctx);
         case Difficulty::Hard:
-            cpuHard();
-            break;
+            return cpuHard(tablero);
+        case Difficulty::MCTS:
+            return cpuMCTS(tablero, ctx);
     }
+    return -1;
+}
+
+std::array<int, 9> ponderar(Bitboard tablero, Difficulty diff, ContextoIA& ctx) {
+    std::array<int, 9> respuestas;
+    respuestas.fill(-1);
+    TableroIncremental t(tablero);
+    for (int casilla : movimientosDisponibles(tablero)) {
+        t.colocar(casilla);   // juega X
+        if (!t.terminado())
+            respuestas[casilla] = elegirMovimiento(t.b, diff, ctx);
+        t.quitar(casilla);
+    }
+    return respuestas;
+}
+
+// f(ctx) con el contexto persistente si está libre, o con uno nuevo
+template <class F>
+static auto conContexto(ContextoPersistente& contexto, F f) {
+    std::unique_lock<std::mutex> lock(contexto.mutex, std::try_to_lock);
+    if (lock.owns_lock()) return f(contexto.ctx);
+    ContextoIA temporal;
+    return f(temporal);
+}
+
+int cpuCalcularMovimiento(Bitboard tablero, Difficulty diff, ContextoPersistente& contexto) {
+    return conContexto(contexto, [&](ContextoIA& ctx) { return elegirMovimiento(tablero, diff, ctx); });
+}
+
+std::array<int, 9> cpuPonderar(Bitboard tablero, Difficulty diff, ContextoPersistente& contexto) {
+    return conContexto(contexto, [&](ContextoIA& ctx) { return ponderar(tablero, diff, ctx); });
 }
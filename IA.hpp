@@ -1,15 +1,294 @@
 // IA.hpp
 #pragma once
+#include "MCTS.hpp"
 #include <array>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <random>
 
-// Tablero 3x3
-extern std::array<std::array<char, 3>, 3> board;
+// Tablero 3x3 como bitboard: una máscara de 9 bits por jugador.
+// La casilla (fila, columna) corresponde al bit fila*3 + columna.
+constexpr std::uint16_t TABLERO_COMPLETO = 0x1FF;
+
+// Las 8 líneas ganadoras: filas, columnas y diagonales
+constexpr std::array<std::uint16_t, 8> LINEAS_GANADORAS = {
+    0x007, 0x038, 0x1C0,   // filas
+    0x049, 0x092, 0x124,   // columnas
+    0x111, 0x054           // diagonales
+};
+
+struct Bitboard {
+    std::uint16_t x = 0;
+    std::uint16_t o = 0;
+
+    static constexpr std::uint16_t bit(int r, int c) { return std::uint16_t(1u << (r * 3 + c)); }
+
+    constexpr char get(int r, int c) const {
+        if (x & bit(r, c)) return 'X';
+        if (o & bit(r, c)) return 'O';
+        return ' ';
+    }
+
+    constexpr void set(int r, int c, char simbolo) {
+        x &= ~bit(r, c);
+        o &= ~bit(r, c);
+        if (simbolo == 'X') x |= bit(r, c);
+        else if (simbolo == 'O') o |= bit(r, c);
+    }
+
+    constexpr bool operator==(const Bitboard&) const = default;
+
+    constexpr std::uint16_t ocupadas() const { return x | o; }
+    constexpr std::uint16_t libres() const { return TABLERO_COMPLETO & ~(x | o); }
+
+    // X siempre abre, así que le toca a O cuando X tiene una ficha más
+    constexpr char turno() const { return std::popcount(x) > std::popcount(o) ? 'O' : 'X'; }
+};
+
+// true si la máscara contiene alguna línea completa
+constexpr bool tieneLinea(std::uint16_t mascara) {
+    for (std::uint16_t linea : LINEAS_GANADORAS)
+        if ((mascara & linea) == linea) return true;
+    return false;
+}
+
+// Código base 3 de un tablero (0 vacía, 1 X, 2 O; casilla i = dígito i):
+// 3^9 = 19683 códigos. Lo usan la tabla de juego perfecto (IA.cpp) y las
+// herramientas que guardan posiciones por código.
+constexpr int CODIGOS_TABLERO = 19683;
+
+constexpr std::array<int, 9> POTENCIAS_3 = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+
+// máscara de 9 bits -> código base 3 con un 1 en cada bit activo
+constexpr std::array<std::uint16_t, 512> generarBase3() {
+    std::array<std::uint16_t, 512> t{};
+    for (int m = 0; m < 512; m++)
+        for (int i = 0; i < 9; i++)
+            if (m & (1 << i)) t[m] += POTENCIAS_3[i];
+    return t;
+}
+constexpr std::array<std::uint16_t, 512> BASE_3 = generarBase3();
+
+constexpr int codigoTablero(const Bitboard& b) {
+    return BASE_3[b.x] + 2 * BASE_3[b.o];
+}
+
+constexpr Bitboard tableroDeCodigo(int codigo) {
+    Bitboard b;
+    for (int i = 0; i < 9; i++, codigo /= 3) {
+        if (codigo % 3 == 1) b.x |= static_cast<std::uint16_t>(1u << i);
+        else if (codigo % 3 == 2) b.o |= static_cast<std::uint16_t>(1u << i);
+    }
+    return b;
+}
+
+// Líneas que pasan por cada casilla: 2 a 4, completadas con -1
+constexpr std::array<std::array<std::int8_t, 4>, 9> generarLineasCasilla() {
+    std::array<std::array<std::int8_t, 4>, 9> t{};
+    for (auto& fila : t) fila.fill(-1);
+    for (int l = 0; l < static_cast<int>(LINEAS_GANADORAS.size()); l++) {
+        for (int casilla = 0; casilla < 9; casilla++) {
+            if (!((LINEAS_GANADORAS[l] >> casilla) & 1)) continue;
+            int k = 0;
+            while (t[casilla][k] != -1) k++;
+            t[casilla][k] = static_cast<std::int8_t>(l);
+        }
+    }
+    return t;
+}
+constexpr std::array<std::array<std::int8_t, 4>, 9> LINEAS_CASILLA = generarLineasCasilla();
+
+// Bitboard con cuentas de fichas por línea y número de jugadas. Cada jugada
+// solo toca las líneas de su casilla, así que saber si alguien ganó o si
+// hubo empate cuesta O(1). Lo usan la partida en gato.cpp y minimax
+// (colocar/quitar en lugar de reevaluar el tablero en cada nodo).
+struct TableroIncremental {
+    Bitboard b;
+    std::array<std::uint8_t, 8> cuentaX{};
+    std::array<std::uint8_t, 8> cuentaO{};
+    int jugadas = 0;
+    int linea = -1;   // índice en LINEAS_GANADORAS de la línea completa, o -1
+
+    constexpr TableroIncremental() = default;
+
+    constexpr explicit TableroIncremental(const Bitboard& inicial) : b(inicial) {
+        for (int l = 0; l < static_cast<int>(LINEAS_GANADORAS.size()); l++) {
+            cuentaX[l] = static_cast<std::uint8_t>(std::popcount(static_cast<std::uint16_t>(b.x & LINEAS_GANADORAS[l])));
+            cuentaO[l] = static_cast<std::uint8_t>(std::popcount(static_cast<std::uint16_t>(b.o & LINEAS_GANADORAS[l])));
+            if (linea < 0 && (cuentaX[l] == 3 || cuentaO[l] == 3)) linea = l;
+        }
+        jugadas = std::popcount(b.ocupadas());
+    }
+
+    constexpr char get(int r, int c) const { return b.get(r, c); }
+    constexpr char turno() const { return (jugadas % 2 == 0) ? 'X' : 'O'; }
+    constexpr bool lleno() const { return jugadas == 9; }
+    constexpr bool terminado() const { return linea >= 0 || lleno(); }
+
+    // 'X', 'O' o ' ' si nadie completó una línea
+    constexpr char ganador() const {
+        if (linea < 0) return ' ';
+        return (cuentaX[linea] == 3) ? 'X' : 'O';
+    }
+
+    // Como evaluar(): 10 si ganó O, -10 si ganó X, 0 si ninguno
+    constexpr int valor() const {
+        if (linea < 0) return 0;
+        return (cuentaO[linea] == 3) ? 10 : -10;
+    }
+
+    // Pone una ficha del bando al que le toca en una casilla libre
+    constexpr void colocar(int casilla) {
+        bool esX = (jugadas % 2 == 0);
+        (esX ? b.x : b.o) |= static_cast<std::uint16_t>(1u << casilla);
+        jugadas++;
+        for (int l : LINEAS_CASILLA[casilla]) {
+            if (l < 0) break;
+            if (++(esX ? cuentaX : cuentaO)[l] == 3) linea = l;
+        }
+    }
+
+    // Deshace colocar(). Como no se juega después de una victoria, la
+    // posición anterior nunca tenía línea completa.
+    constexpr void quitar(int casilla) {
+        std::uint16_t bit = static_cast<std::uint16_t>(1u << casilla);
+        bool esX = (b.x & bit) != 0;
+        (esX ? b.x : b.o) &= static_cast<std::uint16_t>(~bit);
+        jugadas--;
+        for (int l : LINEAS_CASILLA[casilla]) {
+            if (l < 0) break;
+            (esX ? cuentaX : cuentaO)[l]--;
+        }
+        linea = -1;
+    }
+};
 
 // Dificultad
 enum class Difficulty {
     Easy,
     Medium,
-    Hard
+    Hard,
+    MCTS      // Monte Carlo (UCT); su fuerza depende de ContextoIA::mcts
+};
+
+// Contadores de la tabla de transposición de minimax
+struct EstadisticasTT {
+    long long aciertos = 0;
+    long long fallos = 0;
+    long long guardados = 0;
+};
+
+enum class Cota : std::uint8_t { Exacto, Inferior, Superior };
+
+struct EntradaTT {
+    std::uint32_t clave = 0;   // clave canónica + 1 (0 = vacía)
+    std::int8_t valor = 0;     // relativo al nodo, no a la raíz
+    Cota cota = Cota::Exacto;
+};
+
+// Tabla de transposición de minimax. Se conserva entre búsquedas del mismo
+// contexto, así que las siguientes reutilizan lo ya resuelto.
+struct TablaTransposicion {
+    static constexpr int BITS = 12;
+    std::array<EntradaTT, 1 << BITS> entradas{};
+    EstadisticasTT stats;
+
+    void limpiar() {
+        entradas.fill(EntradaTT{});
+        stats = EstadisticasTT{};
+    }
+};
+
+// Estado propio de una partida o de un hilo: generador aleatorio, tabla de
+// transposición, contador de nodos y presupuesto de MCTS. Las funciones de la IA no usan ningún
+// estado global, así que varios contextos pueden jugar a la vez en hilos
+// distintos.
+struct ContextoIA {
+    std::mt19937 rng;
+    TablaTransposicion tt;
+    long long nodos = 0;
+    ConfigMCTS mcts;
+    ResultadoMCTS ultimoMCTS;   // partidas y partidas/s de la última búsqueda MCTS
+
+    explicit ContextoIA(std::uint32_t semilla = std::random_device{}()) : rng(semilla) {}
+};
+
+// Elige la jugada del bando al que le toca (X u O) en el tablero dado.
+// Devuelve la casilla (fila*3 + columna) o -1 si no hay jugada.
+int elegirMovimiento(Bitboard tablero, Difficulty diff, ContextoIA& ctx);
+
+// Pondering: para cada casilla libre calcula la respuesta de la IA si X
+// jugara ahí. respuestas[casilla] es -1 si la casilla está ocupada o si esa
+// jugada de X termina la partida.
+std::array<int, 9> ponderar(Bitboard tablero, Difficulty diff, ContextoIA& ctx);
+
+// Contexto que la interfaz conserva durante toda la partida: la tabla de
+// transposición sigue llena de una jugada a la siguiente y el pondering
+// deja resuelto lo que después busca la jugada. Cada búsqueda lo toma con
+// try_lock; si una búsqueda anterior todavía lo usa (una jugada descartada
+// que no terminó), esta usa un contexto nuevo en vez de esperarla.
+struct ContextoPersistente {
+    std::mutex mutex;
+    ContextoIA ctx;
+};
+
+// Envoltorios para la interfaz, para lanzar con std::async
+int cpuCalcularMovimiento(Bitboard tablero, Difficulty diff, ContextoPersistente& contexto);
+std::array<int, 9> cpuPonderar(Bitboard tablero, Difficulty diff, ContextoPersistente& contexto);
+
+// =========================
+// Piezas internas del motor
+// =========================
+// Expuestas para el benchmark y las herramientas de consola; la interfaz
+// solo necesita lo de arriba.
+
+// Lista de jugadas de capacidad fija que vive en la pila: generar jugadas
+// en cada nodo de la búsqueda no reserva memoria.
+struct ListaMovimientos {
+    std::array<std::uint8_t, 9> casillas{};
+    int cantidad = 0;
+
+    void agregar(int casilla) { casillas[cantidad++] = static_cast<std::uint8_t>(casilla); }
+    bool empty() const { return cantidad == 0; }
+    int size() const { return cantidad; }
+    int operator[](int i) const { return casillas[i]; }
+    const std::uint8_t* begin() const { return casillas.data(); }
+    const std::uint8_t* end() const { return casillas.data() + cantidad; }
+};
+
+// Casillas libres en orden centro, esquinas, lados
+ListaMovimientos movimientosDisponibles(const Bitboard& b);
+
+// 10 si O tiene línea, -10 si la tiene X, 0 si ninguno
+int evaluar(const Bitboard& b);
+bool tableroLleno(const Bitboard& b);
+
+int cpuMedium(const Bitboard& b, ContextoIA& ctx);
+
+// Valor exacto de la tabla de juego perfecto, como el de minimax (desde O,
+// 10 - distancia si gana O). Solo tiene sentido en posiciones legales.
+int valorPerfecto(const Bitboard& b);
+
+// Valor minimax (desde el punto de vista de O) con poda alfa-beta; isMax
+// indica que le toca a O. Suma los nodos visitados en ctx.nodos.
+int minimax(TableroIncremental& t, int profundidad, int alfa, int beta, bool isMax, ContextoIA& ctx);
+
+// Perft: recorre todas las continuaciones con la misma generación de jugadas
+// y detección de fin que minimax() y cuenta nodos y partidas terminadas.
+// Desde el tablero vacío: 549946 nodos, 255168 partidas (131184 gana X,
+// 77904 gana O, 46080 empates).
+struct ResultadoPerft {
+    long long nodos = 0;
+    long long partidas = 0;
+    long long ganaX = 0;
+    long long ganaO = 0;
+    long long empates = 0;
 };
+void perft(TableroIncremental& t, ResultadoPerft& r);
 
-void cpuMakeMove(Difficulty diff);
+// Mejor jugada para el bando al que le toca, buscando en tiempo de ejecución.
+// La segunda forma también devuelve el valor minimax de la posición (desde
+// el punto de vista de O, como minimax()).
+int buscarJugada(const Bitboard& tablero, ContextoIA& ctx);
+int buscarJugada(const Bitboard& tablero, ContextoIA& ctx, int& valor);
@@ -0,0 +1,130 @@
+// LoteDibujo.hpp
+// Geometría 2D en lote: rectángulos y texto se acumulan en arreglos de
+// vértices que se arman una vez y se dibujan con una llamada por arreglo.
+// Los rectángulos van en un solo arreglo; el texto, en uno por tamaño de
+// letra, porque la fuente guarda los glifos de cada tamaño en su propia
+// textura. Al dibujar, primero van las formas y después el texto.
+//
+// El texto se arma glifo por glifo con la misma geometría que sf::Text, así
+// que medirTexto() coincide con sf::Text::getLocalBounds() y las posiciones
+// calculadas como antes quedan iguales.
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <string>
+
+class LoteDibujo {
+public:
+    void limpiar() {
+        formas.clear();
+        for (auto& [tamano, vertices] : textos) vertices.clear();
+    }
+
+    // Rectángulo relleno; el borde, si lo hay, queda por fuera como en
+    // sf::RectangleShape
+    void rectangulo(sf::Vector2f pos, sf::Vector2f tam, sf::Color relleno, float borde = 0.f,
+                    sf::Color colorBorde = sf::Color::Transparent, const sf::Transform& t = sf::Transform()) {
+        cuadrilatero(pos, tam, relleno, relleno, t);
+        if (borde <= 0.f) return;
+        cuadrilatero({pos.x - borde, pos.y - borde}, {tam.x + 2 * borde, borde}, colorBorde, colorBorde, t);
+        cuadrilatero({pos.x - borde, pos.y + tam.y}, {tam.x + 2 * borde, borde}, colorBorde, colorBorde, t);
+        cuadrilatero({pos.x - borde, pos.y}, {borde, tam.y}, colorBorde, colorBorde, t);
+        cuadrilatero({pos.x + tam.x, pos.y}, {borde, tam.y}, colorBorde, colorBorde, t);
+    }
+
+    // Degradado vertical: un solo rectángulo con colores por vértice
+    void degradado(sf::Vector2f pos, sf::Vector2f tam, sf::Color arriba, sf::Color abajo) {
+        cuadrilatero(pos, tam, arriba, abajo, sf::Transform());
+    }
+
+    // Igual que sf::Text::getLocalBounds() para el mismo texto
+    static sf::FloatRect medirTexto(const sf::Font& fuente, const std::string& texto, unsigned tamano, bool negrita) {
+        Medida m = recorrer(fuente, texto, tamano, negrita, [](const sf::Glyph&, float, float) {});
+        return sf::FloatRect({m.minX, m.minY}, {m.maxX - m.minX, m.maxY - m.minY});
+    }
+
+    // Texto con la esquina de su origen en pos (como sf::Text::setPosition),
+    // opcionalmente girado alrededor de ese punto
+    void texto(const sf::Font& fuente, const std::string& texto, unsigned tamano, bool negrita, sf::Vector2f pos,
+               sf::Color color, sf::Angle angulo = sf::degrees(0.f)) {
+        fuenteTexto = &fuente;
+        sf::Transform t;
+        t.translate(pos);
+        t.rotate(angulo);
+        sf::VertexArray& vertices = textos.try_emplace(tamano, sf::PrimitiveType::Triangles).first->second;
+        recorrer(fuente, texto, tamano, negrita, [&](const sf::Glyph& glifo, float x, float y) {
+            // un píxel de margen alrededor del glifo, igual que sf::Text
+            const float margen = 1.f;
+            sf::Vector2f p1{glifo.bounds.position.x - margen, glifo.bounds.position.y - margen};
+            sf::Vector2f p2{glifo.bounds.position.x + glifo.bounds.size.x + margen,
+                            glifo.bounds.position.y + glifo.bounds.size.y + margen};
+            sf::Vector2f uv1{glifo.textureRect.position.x - margen, glifo.textureRect.position.y - margen};
+            sf::Vector2f uv2{glifo.textureRect.position.x + glifo.textureRect.size.x + margen,
+                             glifo.textureRect.position.y + glifo.textureRect.size.y + margen};
+            sf::Vector2f esquinas[4] = {{x + p1.x, y + p1.y}, {x + p2.x, y + p1.y},
+                                        {x + p1.x, y + p2.y}, {x + p2.x, y + p2.y}};
+            sf::Vector2f uvs[4] = {{uv1.x, uv1.y}, {uv2.x, uv1.y}, {uv1.x, uv2.y}, {uv2.x, uv2.y}};
+            for (int i : {0, 1, 2, 2, 1, 3})
+                vertices.append(sf::Vertex{t.transformPoint(esquinas[i]), color, uvs[i]});
+        });
+    }
+
+    void dibujar(sf::RenderTarget& destino, sf::RenderStates estados = sf::RenderStates()) const {
+        if (formas.getVertexCount() > 0) destino.draw(formas, estados);
+        for (const auto& [tamano, vertices] : textos) {
+            if (vertices.getVertexCount() == 0) continue;
+            sf::RenderStates conTextura = estados;
+            conTextura.texture = &fuenteTexto->getTexture(tamano);
+            destino.draw(vertices, conTextura);
+        }
+    }
+
+private:
+    sf::VertexArray formas{sf::PrimitiveType::Triangles};
+    std::map<unsigned, sf::VertexArray> textos;   // tamaño de letra -> glifos
+    const sf::Font* fuenteTexto = nullptr;
+
+    struct Medida {
+        float minX, minY, maxX, maxY;
+    };
+
+    void cuadrilatero(sf::Vector2f pos, sf::Vector2f tam, sf::Color arriba, sf::Color abajo, const sf::Transform& t) {
+        sf::Vector2f esquinas[4] = {pos, {pos.x + tam.x, pos.y}, {pos.x, pos.y + tam.y}, {pos.x + tam.x, pos.y + tam.y}};
+        sf::Color colores[4] = {arriba, arriba, abajo, abajo};
+        for (int i : {0, 1, 2, 2, 1, 3}) formas.append(sf::Vertex{t.transformPoint(esquinas[i]), colores[i], {}});
+    }
+
+    // Recorre el texto como sf::Text: línea base en y = tamaño, con el
+    // interletraje de la fuente; llama a glifo(g, x, y) por cada letra visible
+    template <class F>
+    static Medida recorrer(const sf::Font& fuente, const std::string& texto, unsigned tamano, bool negrita, F glifo) {
+        float espacio = fuente.getGlyph(U' ', tamano, negrita).advance;
+        float x = 0.f;
+        float y = static_cast<float>(tamano);
+        Medida m{y, y, 0.f, 0.f};
+        char32_t anterior = 0;
+        for (unsigned char c : texto) {
+            char32_t actual = c;
+            x += fuente.getKerning(anterior, actual, tamano, negrita);
+            anterior = actual;
+            if (actual == U' ') {
+                m.minX = std::min(m.minX, x);
+                m.minY = std::min(m.minY, y);
+                x += espacio;
+                m.maxX = std::max(m.maxX, x);
+                m.maxY = std::max(m.maxY, y);
+                continue;
+            }
+            const sf::Glyph& g = fuente.getGlyph(actual, tamano, negrita);
+            glifo(g, x, y);
+            m.minX = std::min(m.minX, x + g.bounds.position.x);
+            m.maxX = std::max(m.maxX, x + g.bounds.position.x + g.bounds.size.x);
+            m.minY = std::min(m.minY, y + g.bounds.position.y);
+            m.maxY = std::max(m.maxY, y + g.bounds.position.y + g.bounds.size.y);
+            x += g.advance;
+        }
+        return m;
+    }
+};
@@ -0,0 +1,269 @@
+// MCTS.hpp
+// Búsqueda de árbol Monte Carlo (UCT) para tableros N x N con K en línea.
+// Cada hilo construye su propio árbol desde la raíz (paralelización en la
+// raíz) con partidas aleatorias sobre bitboards; al final se suman las
+// visitas de las jugadas de la raíz y gana la más visitada. El presupuesto
+// de partidas es de cada hilo, así que con más núcleos se juegan más
+// partidas en el mismo tiempo y la fuerza crece con ellos.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+struct ConfigMCTS {
+    long long partidas = 20000;   // partidas aleatorias de cada hilo
+    int milisegundos = 0;         // si es > 0, también corta por tiempo
+    int hilos = 0;                // 0 = todos los núcleos
+    double exploracion = 1.41;    // constante C de UCT
+};
+
+struct ResultadoMCTS {
+    int casilla = -1;
+    long long partidas = 0;
+    double segundos = 0;
+    double partidasPorSegundo = 0;
+};
+
+template <int N, int K>
+class MCTSNxN {
+    static_assert(N >= 3 && N <= 19 && K >= 3 && K <= N, "tablero de 3x3 a 19x19, K entre 3 y N");
+
+public:
+    static constexpr int CELDAS = N * N;
+    static constexpr int PALABRAS = (CELDAS + 63) / 64;
+    using Mascara = std::array<std::uint64_t, PALABRAS>;
+
+    // celdas: 0 vacía, 1 X, 2 O. Juega el bando al que le toca (X abre).
+    static ResultadoMCTS buscar(const std::array<std::uint8_t, CELDAS>& celdas, const ConfigMCTS& cfg,
+                                std::uint64_t semilla) {
+        Posicion raiz;
+        for (int i = 0; i < CELDAS; i++) {
+            if (celdas[i] == 1) poner(raiz.x, i);
+            else if (celdas[i] == 2) poner(raiz.o, i);
+            if (celdas[i] != 0) raiz.ocupadas++;
+        }
+
+        int hilos = cfg.hilos > 0 ? cfg.hilos : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::array<long long, CELDAS>> visitas(hilos);
+        std::vector<long long> partidas(hilos, 0);
+
+        auto inicio = std::chrono::steady_clock::now();
+        std::vector<std::thread> trabajadores;
+        for (int h = 0; h < hilos; h++) {
+            trabajadores.emplace_back([&, h] {
+                Arbol arbol(raiz, cfg, semilla + 0x9E3779B97F4A7C15ull * (h + 1));
+                partidas[h] = arbol.ejecutar(cfg.partidas, inicio);
+                visitas[h] = arbol.visitasRaiz();
+            });
+        }
+        for (auto& t : trabajadores) t.join();
+
+        // Fusión: suma de visitas por casilla de todos los árboles
+        ResultadoMCTS res;
+        std::array<long long, CELDAS> total{};
+        for (int h = 0; h < hilos; h++) {
+            res.partidas += partidas[h];
+            for (int i = 0; i < CELDAS; i++) total[i] += visitas[h][i];
+        }
+        long long mejor = 0;
+        for (int i = 0; i < CELDAS; i++) {
+            if (total[i] > mejor) {
+                mejor = total[i];
+                res.casilla = i;
+            }
+        }
+        res.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        res.partidasPorSegundo = res.segundos > 0 ? res.partidas / res.segundos : 0;
+        return res;
+    }
+
+private:
+    enum Estado : std::uint8_t { EN_CURSO = 0, GANA_X = 1, GANA_O = 2, EMPATE = 3 };
+
+    struct Posicion {
+        Mascara x{};
+        Mascara o{};
+        int ocupadas = 0;
+
+        bool libre(int i) const { return !tiene(x, i) && !tiene(o, i); }
+        int turno() const { return (ocupadas % 2 == 0) ? 1 : 2; }
+    };
+
+    static bool tiene(const Mascara& m, int i) { return (m[i >> 6] >> (i & 63)) & 1u; }
+    static void poner(Mascara& m, int i) { m[i >> 6] |= std::uint64_t(1) << (i & 63); }
+
+    // ¿La ficha recién puesta en la casilla completa K en línea?
+    static bool completaLinea(const Mascara& m, int casilla) {
+        constexpr int direcciones[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        int r0 = casilla / N, c0 = casilla % N;
+        for (const auto& d : direcciones) {
+            int seguidas = 1;
+            for (int sentido = -1; sentido <= 1; sentido += 2) {
+                int r = r0 + sentido * d[0], c = c0 + sentido * d[1];
+                while (r >= 0 && r < N && c >= 0 && c < N && tiene(m, r * N + c)) {
+                    seguidas++;
+                    r += sentido * d[0];
+                    c += sentido * d[1];
+                }
+            }
+            if (seguidas >= K) return true;
+        }
+        return false;
+    }
+
+    // Juega en la casilla y devuelve el estado resultante
+    static Estado jugar(Posicion& p, int casilla) {
+        int jugador = p.turno();
+        Mascara& m = (jugador == 1) ? p.x : p.o;
+        poner(m, casilla);
+        p.ocupadas++;
+        if (completaLinea(m, casilla)) return jugador == 1 ? GANA_X : GANA_O;
+        return p.ocupadas == CELDAS ? EMPATE : EN_CURSO;
+    }
+
+    // En tableros grandes solo se consideran casillas cerca de las fichas
+    static bool candidata(const Posicion& p, int casilla) {
+        if (!p.libre(casilla)) return false;
+        if (N <= 4) return true;
+        if (p.ocupadas == 0) return casilla == (N / 2) * N + N / 2;
+        int r0 = casilla / N, c0 = casilla % N;
+        for (int r = std::max(0, r0 - 2); r <= std::min(N - 1, r0 + 2); r++)
+            for (int c = std::max(0, c0 - 2); c <= std::min(N - 1, c0 + 2); c++)
+                if (!p.libre(r * N + c)) return true;
+        return false;
+    }
+
+    // Los hijos se expanden de a uno, en orden de casilla, y se enlazan como
+    // lista: el árbol crece un nodo por partida como mucho.
+    struct Nodo {
+        std::int32_t primerHijo = -1;
+        std::int32_t hermano = -1;
+        std::int16_t casilla = -1;
+        std::int16_t siguiente = 0;    // próxima casilla a probar para expandir
+        std::uint8_t jugador = 0;      // quien jugó para llegar a este nodo
+        std::uint8_t estado = EN_CURSO;
+        std::int32_t visitas = 0;
+        float puntos = 0;              // victorias + empates/2, para `jugador`
+    };
+
+    class Arbol {
+    public:
+        Arbol(const Posicion& raiz, const ConfigMCTS& cfg, std::uint64_t semilla)
+            : raiz(raiz), cfg(cfg), rng(semilla) {
+            nodos.reserve(static_cast<std::size_t>(std::min<long long>(cfg.partidas, 1 << 20)) + 1);
+            Nodo n;
+            n.jugador = static_cast<std::uint8_t>(3 - raiz.turno());
+            nodos.push_back(n);
+        }
+
+        long long ejecutar(long long cupo, std::chrono::steady_clock::time_point inicio) {
+            auto limite = inicio + std::chrono::milliseconds(cfg.milisegundos);
+            long long hechas = 0;
+            for (; hechas < cupo; hechas++) {
+                if (cfg.milisegundos > 0 && (hechas & 63) == 0 && std::chrono::steady_clock::now() > limite) break;
+                iteracion();
+            }
+            return hechas;
+        }
+
+        std::array<long long, CELDAS> visitasRaiz() const {
+            std::array<long long, CELDAS> v{};
+            for (int h = nodos[0].primerHijo; h != -1; h = nodos[h].hermano)
+                v[nodos[h].casilla] = nodos[h].visitas;
+            return v;
+        }
+
+    private:
+        Posicion raiz;
+        ConfigMCTS cfg;
+        std::mt19937_64 rng;
+        std::vector<Nodo> nodos;
+        std::vector<std::int32_t> camino;
+
+        void iteracion() {
+            Posicion p = raiz;
+            camino.clear();
+            int actual = 0;
+            camino.push_back(actual);
+
+            // Selección y expansión
+            while (nodos[actual].estado == EN_CURSO) {
+                int nuevo = expandir(actual, p);
+                if (nuevo != -1) {
+                    actual = nuevo;
+                    camino.push_back(actual);
+                    break;
+                }
+                actual = seleccionarUCT(actual);
+                if (actual == -1) break;
+                jugar(p, nodos[actual].casilla);
+                camino.push_back(actual);
+            }
+
+            // Simulación
+            int resultado = nodos[camino.back()].estado;
+            if (resultado == EN_CURSO) resultado = partidaAleatoria(p);
+
+            // Retropropagación
+            for (int idx : camino) {
+                Nodo& n = nodos[idx];
+                n.visitas++;
+                if (resultado == EMPATE) n.puntos += 0.5f;
+                else if (resultado == n.jugador) n.puntos += 1.f;
+            }
+        }
+
+        // Añade el siguiente hijo sin probar, si queda alguno
+        int expandir(int idx, Posicion& p) {
+            Nodo& n = nodos[idx];
+            while (n.siguiente < CELDAS && !candidata(p, n.siguiente)) n.siguiente++;
+            if (n.siguiente >= CELDAS) return -1;
+
+            Nodo hijo;
+            hijo.casilla = n.siguiente++;
+            hijo.jugador = static_cast<std::uint8_t>(p.turno());
+            hijo.estado = jugar(p, hijo.casilla);
+            hijo.hermano = n.primerHijo;
+            int nuevo = static_cast<int>(nodos.size());
+            nodos[idx].primerHijo = nuevo;
+            nodos.push_back(hijo);
+            return nuevo;
+        }
+
+        int seleccionarUCT(int idx) const {
+            double logPadre = std::log(static_cast<double>(nodos[idx].visitas) + 1.0);
+            double mejor = -1;
+            int elegido = -1;
+            for (int h = nodos[idx].primerHijo; h != -1; h = nodos[h].hermano) {
+                const Nodo& n = nodos[h];
+                double uct = n.puntos / n.visitas + cfg.exploracion * std::sqrt(logPadre / n.visitas);
+                if (uct > mejor) {
+                    mejor = uct;
+                    elegido = h;
+                }
+            }
+            return elegido;
+        }
+
+        int partidaAleatoria(Posicion& p) {
+            std::array<std::int16_t, CELDAS> libres;
+            int cantidad = 0;
+            for (int i = 0; i < CELDAS; i++)
+                if (p.libre(i)) libres[cantidad++] = static_cast<std::int16_t>(i);
+
+            while (cantidad > 0) {
+                int k = static_cast<int>(rng() % cantidad);
+                int casilla = libres[k];
+                libres[k] = libres[--cantidad];
+                Estado e = jugar(p, casilla);
+                if (e != EN_CURSO) return e;
+            }
+            return EMPATE;
+        }
+    };
+};
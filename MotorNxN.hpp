@@ -0,0 +1,583 @@
+// MotorNxN.hpp
+// Motor generalizado: tablero N x N (hasta 19 x 19) y K en línea para ganar.
+// Minimax completo solo es viable en 3x3, así que aquí se usa alfa-beta con
+// profundización iterativa bajo un presupuesto de tiempo por jugada y una
+// evaluación heurística que cuenta líneas abiertas.
+//
+// Con un PoolHilos la búsqueda se reparte entre núcleos al estilo "young
+// brothers wait": en cada nodo profundo se busca primero el hijo más
+// prometedor y, si no hubo corte, sus hermanos se lanzan como tareas, cada
+// una sobre su propia copia de la posición y todas con la misma tabla de
+// transposición. El valor de cada nodo no depende del orden de visita (la
+// tabla solo se usa con la misma profundidad), así que la jugada elegida es
+// la misma que sin pool.
+//
+// En tableros de hasta 4x4 se le puede dar una base resuelta por solver.cpp
+// (usarBase): si coincide con N y K, la jugada sale de la base sin buscar
+// (Resultado::nodos queda en 0).
+#pragma once
+#include "BaseDatos.hpp"
+#include "PoolHilos.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+template <int N, int K>
+class MotorNxN {
+    static_assert(N >= 3 && N <= 19, "el tablero va de 3x3 a 19x19");
+    static_assert(K >= 3 && K <= N, "K debe estar entre 3 y N");
+
+public:
+    static constexpr int CELDAS = N * N;
+    static constexpr int VACIA = 0, X = 1, O = 2;
+    static constexpr int GANA = 1000000000;   // valor de victoria antes de restar la distancia
+
+    struct Resultado {
+        int casilla = -1;          // fila * N + columna
+        int valor = 0;             // desde el punto de vista del bando que juega
+        int profundidad = 0;       // última iteración completada
+        long long nodos = 0;
+    };
+
+    MotorNxN() : t(&tablas()) {
+        ttPropia = std::make_unique<EntradaTT[]>(std::size_t(1) << BITS_TT);
+        tt = ttPropia.get();
+        historiaPropia = std::make_unique<Historia>();
+        historia = historiaPropia.get();
+        reiniciar();
+    }
+
+    MotorNxN(const MotorNxN&) = delete;
+    MotorNxN& operator=(const MotorNxN&) = delete;
+
+    void reiniciar() {
+        celdas.fill(VACIA);
+        cercanas.fill(0);
+        cuentaX.fill(0);
+        cuentaO.fill(0);
+        ocupadas = 0;
+        ganadorActual = VACIA;
+        evalX = 0;
+        hash = 0;
+        for (auto& fila : *historia)
+            for (auto& h : fila) h.store(0, std::memory_order_relaxed);
+    }
+
+    int get(int casilla) const { return celdas[casilla]; }
+    int turno() const { return (ocupadas % 2 == 0) ? X : O; }
+    int ganador() const { return ganadorActual; }
+    bool lleno() const { return ocupadas == CELDAS; }
+    bool terminado() const { return ganadorActual != VACIA || lleno(); }
+
+    // Coloca una ficha del bando al que le toca. Actualiza en O(K) las
+    // cuentas de cada ventana que pasa por la casilla, la evaluación y el
+    // hash, así que deshacer con quitar() es igual de barato.
+    void colocar(int casilla) {
+        int jugador = turno();
+        celdas[casilla] = static_cast<std::uint8_t>(jugador);
+        ocupadas++;
+        hash ^= t->zobrist[jugador - 1][casilla];
+        for (int i = 0; i < t->numVentanasCasilla[casilla]; i++) {
+            int v = t->ventanasCasilla[casilla][i];
+            evalX -= contribucion(v);
+            std::uint8_t& cuenta = (jugador == X) ? cuentaX[v] : cuentaO[v];
+            if (++cuenta == K) ganadorActual = jugador;
+            evalX += contribucion(v);
+        }
+        ajustarCercanas(casilla, +1);
+    }
+
+    void quitar(int casilla) {
+        int jugador = celdas[casilla];
+        for (int i = 0; i < t->numVentanasCasilla[casilla]; i++) {
+            int v = t->ventanasCasilla[casilla][i];
+            evalX -= contribucion(v);
+            ((jugador == X) ? cuentaX[v] : cuentaO[v])--;
+            evalX += contribucion(v);
+        }
+        ajustarCercanas(casilla, -1);
+        hash ^= t->zobrist[jugador - 1][casilla];
+        celdas[casilla] = VACIA;
+        ocupadas--;
+        ganadorActual = VACIA;   // la búsqueda nunca juega después de una victoria
+    }
+
+    // Base de posiciones resueltas (nullptr para no usar ninguna). Se abre
+    // recién en la primera jugada.
+    void usarBase(BaseDatos* baseResuelta) { base = baseResuelta; }
+
+    // Profundización iterativa: busca a profundidad 1, 2, 3... hasta agotar
+    // el presupuesto y devuelve la jugada de la última iteración completa.
+    // Con pool, cada iteración se reparte entre sus hilos.
+    Resultado buscar(std::chrono::milliseconds presupuesto, int profundidadMaxima = 64,
+                     PoolHilos* poolHilos = nullptr) {
+        Resultado res;
+        if (consultarBase(res)) return res;
+
+        nodos = 0;
+        abortado = false;
+        pool = poolHilos;
+        limite = std::chrono::steady_clock::now() + presupuesto;
+
+        Jugadas jugadas;
+        generarJugadas(jugadas);
+        if (jugadas.cantidad == 0) return res;
+        res.casilla = jugadas.casillas[0];
+
+        int maxima = std::min(profundidadMaxima, CELDAS - ocupadas);
+        for (int profundidad = 1; profundidad <= maxima; profundidad++) {
+            int mejorCasilla = -1;
+            int valor = buscarRaiz(profundidad, res.casilla, mejorCasilla);
+            if (abortado) break;
+
+            res.casilla = mejorCasilla;
+            res.valor = valor;
+            res.profundidad = profundidad;
+            // victoria o derrota forzada: buscar más hondo no cambia nada
+            if (valor > GANA - CELDAS - 1 || valor < -GANA + CELDAS + 1) break;
+        }
+        res.nodos = nodos;
+        return res;
+    }
+
+private:
+    static constexpr int MAX_VENTANAS = 4 * CELDAS;
+    static constexpr int BITS_TT = 18;
+    static constexpr int INFINITO = GANA + 1;
+    // Profundidad restante mínima para repartir los hermanos entre hilos:
+    // por debajo, el costo de la tarea supera al del subárbol
+    static constexpr int PROFUNDIDAD_DIVISION = 3;
+
+    enum Cota : std::uint8_t { EXACTO, INFERIOR, SUPERIOR };
+
+    // La tabla se comparte entre los hilos del pool sin cerrojos: cada
+    // entrada guarda los datos empaquetados en 64 bits y la clave XOR los
+    // datos, así que una escritura a medias no coincide con ninguna clave.
+    struct EntradaTT {
+        std::atomic<std::uint64_t> claveXor{0};
+        std::atomic<std::uint64_t> datos{0};
+    };
+
+    struct DatosTT {
+        int valor = 0;
+        int jugada = -1;
+        int profundidad = -1;
+        Cota cota = EXACTO;
+    };
+
+    static std::uint64_t empaquetar(const DatosTT& d) {
+        return std::uint64_t(std::uint32_t(d.valor)) | (std::uint64_t(std::uint16_t(d.jugada)) << 32) |
+               (std::uint64_t(std::uint8_t(d.profundidad)) << 48) | (std::uint64_t(d.cota) << 56);
+    }
+
+    static DatosTT desempaquetar(std::uint64_t bits) {
+        return {static_cast<std::int32_t>(bits), static_cast<std::int16_t>(bits >> 32),
+                static_cast<std::int8_t>(bits >> 48), static_cast<Cota>(bits >> 56)};
+    }
+
+    bool leerTT(std::uint64_t clave, DatosTT& d) const {
+        const EntradaTT& e = tt[clave & ((std::size_t(1) << BITS_TT) - 1)];
+        std::uint64_t bits = e.datos.load(std::memory_order_relaxed);
+        if ((e.claveXor.load(std::memory_order_relaxed) ^ bits) != clave) return false;
+        d = desempaquetar(bits);
+        return true;
+    }
+
+    void escribirTT(std::uint64_t clave, const DatosTT& d) {
+        EntradaTT& e = tt[clave & ((std::size_t(1) << BITS_TT) - 1)];
+        std::uint64_t bits = empaquetar(d);
+        e.claveXor.store(clave ^ bits, std::memory_order_relaxed);
+        e.datos.store(bits, std::memory_order_relaxed);
+    }
+
+    // Lista de jugadas en la pila, como ListaMovimientos en IA.hpp
+    struct Jugadas {
+        std::array<std::int16_t, CELDAS> casillas;
+        int cantidad = 0;
+    };
+
+    // Tablas fijas, compartidas por todos los motores del mismo N y K:
+    // ventanas (todos los segmentos de K casillas en las 4 direcciones) y
+    // claves Zobrist
+    struct Tablas {
+        int numVentanas = 0;
+        std::array<std::array<std::int16_t, 4 * K>, CELDAS> ventanasCasilla{};
+        std::array<std::uint8_t, CELDAS> numVentanasCasilla{};
+        std::array<std::array<std::uint64_t, CELDAS>, 2> zobrist{};
+
+        Tablas() {
+            constexpr std::array<std::array<int, 2>, 4> direcciones = {{{0, 1}, {1, 0}, {1, 1}, {1, -1}}};
+            for (int r = 0; r < N; r++) {
+                for (int c = 0; c < N; c++) {
+                    for (auto [dr, dc] : direcciones) {
+                        int rFin = r + dr * (K - 1), cFin = c + dc * (K - 1);
+                        if (rFin < 0 || rFin >= N || cFin < 0 || cFin >= N) continue;
+                        for (int i = 0; i < K; i++) {
+                            int casilla = (r + dr * i) * N + (c + dc * i);
+                            ventanasCasilla[casilla][numVentanasCasilla[casilla]++] = static_cast<std::int16_t>(numVentanas);
+                        }
+                        numVentanas++;
+                    }
+                }
+            }
+            std::mt19937_64 rng(0x9A70u);
+            for (auto& fila : zobrist)
+                for (auto& k : fila) k = rng();
+        }
+    };
+
+    static const Tablas& tablas() {
+        static const Tablas instancia;
+        return instancia;
+    }
+
+    // Punto de división: si un hermano corta, los demás se cancelan. Cada
+    // tarea mira la cadena hasta la raíz.
+    struct Corte {
+        std::atomic<bool> cortado{false};
+        const Corte* padre = nullptr;
+    };
+
+    const Tablas* t;
+
+    std::array<std::uint8_t, CELDAS> celdas{};
+    int ocupadas = 0;
+    int ganadorActual = VACIA;
+
+    std::array<std::uint8_t, MAX_VENTANAS> cuentaX{};
+    std::array<std::uint8_t, MAX_VENTANAS> cuentaO{};
+    int evalX = 0;   // suma de contribuciones, positiva si favorece a X
+
+    // fichas a distancia <= 2 de cada casilla; solo se generan jugadas cerca
+    // de las fichas existentes
+    std::array<std::uint8_t, CELDAS> cercanas{};
+
+    std::uint64_t hash = 0;
+    std::unique_ptr<EntradaTT[]> ttPropia;
+    EntradaTT* tt = nullptr;   // la propia, o la del motor que lanzó la tarea
+    // Historia de cortes por bando y casilla, también compartida con las
+    // tareas. Solo ordena jugadas, así que perder un incremento entre hilos
+    // no importa: se lee y escribe sin operaciones atómicas compuestas.
+    using Historia = std::array<std::array<std::atomic<int>, CELDAS>, 2>;
+    std::unique_ptr<Historia> historiaPropia;
+    Historia* historia = nullptr;
+
+    long long nodos = 0;
+    bool abortado = false;
+    std::chrono::steady_clock::time_point limite;
+    PoolHilos* pool = nullptr;
+    const Corte* corte = nullptr;
+    BaseDatos* base = nullptr;
+
+    // Jugada perfecta desde la base: la que deja al rival perdido más cerca
+    // del final, si no una que empate, y si todas pierden la que más lo
+    // demora. Sin distancias (base de 2 bits) gana con la primera que deje al
+    // rival perdido y, si todas pierden, busca para resistir. Devuelve false
+    // si no hay base para este tablero.
+    bool consultarBase(Resultado& res) {
+        if constexpr (CELDAS > 16) {
+            (void)res;
+            return false;
+        } else {
+            if (base == nullptr || !base->coincide(N, K) || terminado()) return false;
+            std::uint32_t codigo = 0, potencia = 1;
+            std::array<std::uint32_t, CELDAS> potencias{};
+            for (int i = 0; i < CELDAS; i++) {
+                potencias[i] = potencia;
+                codigo += celdas[i] * potencia;
+                potencia *= 3;
+            }
+            int gana = -1, distanciaGana = 0, empate = -1, pierde = -1, distanciaPierde = -1;
+            for (int casilla = 0; casilla < CELDAS; casilla++) {
+                if (celdas[casilla] != VACIA) continue;
+                std::uint32_t hijo = codigo + turno() * potencias[casilla];
+                ValorBase v = base->valor(hijo);
+                int d = base->distancia(hijo);
+                if (v == ValorBase::Pierde && (gana < 0 || d < distanciaGana)) {
+                    gana = casilla;
+                    distanciaGana = d;
+                } else if (v == ValorBase::Empate && empate < 0) {
+                    empate = casilla;
+                } else if (v == ValorBase::Gana && d >= 0 && d > distanciaPierde) {
+                    pierde = casilla;
+                    distanciaPierde = d;
+                }
+            }
+            // valores como los de la búsqueda: GANA menos las jugadas hasta el final
+            if (gana >= 0) {
+                res.casilla = gana;
+                res.valor = GANA - (std::max(distanciaGana, 0) + 1);
+            } else if (empate >= 0) {
+                res.casilla = empate;
+                res.valor = 0;
+            } else if (pierde >= 0) {
+                res.casilla = pierde;
+                res.valor = -(GANA - (distanciaPierde + 1));
+            } else {
+                return false;
+            }
+            return true;
+        }
+    }
+
+    // Copia de la posición para una tarea del pool; comparte la tabla
+    MotorNxN(const MotorNxN& otro, const Corte* corteTarea)
+        : t(otro.t), celdas(otro.celdas), ocupadas(otro.ocupadas), ganadorActual(otro.ganadorActual),
+          cuentaX(otro.cuentaX), cuentaO(otro.cuentaO), evalX(otro.evalX), cercanas(otro.cercanas),
+          hash(otro.hash), tt(otro.tt), historia(otro.historia), limite(otro.limite),
+          pool(otro.pool), corte(corteTarea) {}
+
+    bool debeParar() const {
+        if (std::chrono::steady_clock::now() > limite) return true;
+        for (const Corte* c = corte; c != nullptr; c = c->padre)
+            if (c->cortado.load(std::memory_order_relaxed)) return true;
+        return false;
+    }
+
+    void premiarCorte(int casilla, int profundidad) {
+        std::atomic<int>& h = (*historia)[turno() - 1][casilla];
+        h.store(h.load(std::memory_order_relaxed) + profundidad * profundidad, std::memory_order_relaxed);
+    }
+
+    static void subirAlfa(std::atomic<int>& alfa, int v) {
+        int actual = alfa.load();
+        while (v > actual && !alfa.compare_exchange_weak(actual, v)) {}
+    }
+
+    // Una ventana sin fichas del rival es una línea abierta: vale más cuantas
+    // más fichas propias tenga. Las bloqueadas por ambos no cuentan. El tope
+    // mantiene la suma de todas las ventanas muy por debajo de GANA.
+    static constexpr int pesoLinea(int fichas) {
+        int peso = 0;
+        for (int i = 0; i < fichas; i++) peso = (peso == 0) ? 1 : std::min(peso * 8, 1 << 16);
+        return peso;
+    }
+
+    int contribucion(int v) const {
+        if (cuentaO[v] == 0) return pesoLinea(cuentaX[v]);
+        if (cuentaX[v] == 0) return -pesoLinea(cuentaO[v]);
+        return 0;
+    }
+
+    void ajustarCercanas(int casilla, int delta) {
+        int r0 = casilla / N, c0 = casilla % N;
+        for (int r = std::max(0, r0 - 2); r <= std::min(N - 1, r0 + 2); r++)
+            for (int c = std::max(0, c0 - 2); c <= std::min(N - 1, c0 + 2); c++)
+                cercanas[r * N + c] = static_cast<std::uint8_t>(cercanas[r * N + c] + delta);
+    }
+
+    void generarJugadas(Jugadas& jugadas) const {
+        jugadas.cantidad = 0;
+        if (ocupadas == 0) {
+            jugadas.casillas[jugadas.cantidad++] = static_cast<std::int16_t>((N / 2) * N + N / 2);
+            return;
+        }
+        for (int casilla = 0; casilla < CELDAS; casilla++)
+            if (celdas[casilla] == VACIA && (cercanas[casilla] > 0 || N <= 4))
+                jugadas.casillas[jugadas.cantidad++] = static_cast<std::int16_t>(casilla);
+    }
+
+    // Primero la jugada sugerida (tabla o iteración anterior), luego por
+    // historia y a igualdad por casilla. std::sort no reserva memoria, a
+    // diferencia de stable_sort.
+    void ordenarJugadas(Jugadas& jugadas, int primera) const {
+        // copia de la historia: otros hilos pueden cambiarla durante el sort
+        std::array<int, CELDAS> h;
+        for (int i = 0; i < jugadas.cantidad; i++) {
+            int casilla = jugadas.casillas[i];
+            h[casilla] = (*historia)[turno() - 1][casilla].load(std::memory_order_relaxed);
+        }
+        std::sort(jugadas.casillas.begin(), jugadas.casillas.begin() + jugadas.cantidad,
+                  [&](int a, int b) {
+                      if ((a == primera) != (b == primera)) return a == primera;
+                      if (h[a] != h[b]) return h[a] > h[b];
+                      return a < b;
+                  });
+    }
+
+    // Con ventana (alfa - 1, +inf) los empates con la mejor jugada también
+    // tienen valor exacto, así que a igual valor gana la casilla más baja sin
+    // importar el orden de búsqueda: serie y pool eligen la misma jugada.
+    int buscarRaiz(int profundidad, int sugerida, int& mejorCasilla) {
+        Jugadas jugadas;
+        generarJugadas(jugadas);
+        ordenarJugadas(jugadas, sugerida);
+
+        int mejor = -INFINITO;
+        auto considerar = [&](int casilla, int v) {
+            if (v > mejor || (v == mejor && casilla < mejorCasilla)) {
+                mejor = v;
+                mejorCasilla = casilla;
+            }
+        };
+
+        for (int i = 0; i < jugadas.cantidad; i++) {
+            if (i == 1 && pool != nullptr) break;
+            int casilla = jugadas.casillas[i];
+            colocar(casilla);
+            int v = -negamax(profundidad - 1, -INFINITO, 1 - mejor, 1);
+            quitar(casilla);
+            if (abortado) return mejor;
+            considerar(casilla, v);
+        }
+        if (pool == nullptr || jugadas.cantidad < 2) return mejor;
+
+        // La primera jugada ya fijó alfa: el resto de la raíz va al pool
+        struct Parcial {
+            int valor = 0;
+            long long nodos = 0;
+            bool abortado = true;
+        };
+        std::vector<Parcial> parciales(jugadas.cantidad);
+        std::atomic<int> alfa{mejor};
+        PoolHilos::Grupo grupo;
+        // se lanzan al revés: el hilo dueño saca por el final y así empieza
+        // por la jugada mejor ordenada
+        for (int i = jugadas.cantidad - 1; i >= 1; i--) {
+            pool->lanzar(grupo, [&, i] {
+                MotorNxN ayudante(*this, corte);
+                if (ayudante.debeParar()) return;
+                ayudante.colocar(jugadas.casillas[i]);
+                Parcial& p = parciales[i];
+                p.valor = -ayudante.negamax(profundidad - 1, -INFINITO, 1 - alfa.load(), 1);
+                p.nodos = ayudante.nodos;
+                p.abortado = ayudante.abortado;
+                if (!p.abortado) subirAlfa(alfa, p.valor);
+            });
+        }
+        pool->esperar(grupo);
+
+        for (int i = 1; i < jugadas.cantidad; i++) {
+            nodos += parciales[i].nodos;
+            if (parciales[i].abortado) abortado = true;
+            else considerar(jugadas.casillas[i], parciales[i].valor);
+        }
+        return mejor;
+    }
+
+    int negamax(int profundidad, int alfa, int beta, int ply) {
+        if ((++nodos & 1023) == 0 && debeParar()) abortado = true;
+        if (abortado) return 0;
+
+        if (ganadorActual != VACIA) return -(GANA - ply);   // ganó quien acaba de jugar
+        if (lleno()) return 0;
+        if (profundidad == 0) return (turno() == X) ? evalX : -evalX;
+
+        // Solo se usan valores de la misma profundidad: así el valor de cada
+        // nodo no depende de qué se buscó antes ni en qué hilo
+        DatosTT entrada;
+        int jugadaTT = -1;
+        if (leerTT(hash, entrada)) {
+            jugadaTT = entrada.jugada;
+            if (entrada.profundidad == profundidad) {
+                int v = desdeTT(entrada.valor, ply);
+                if (entrada.cota == EXACTO) return v;
+                if (entrada.cota == INFERIOR && v >= beta) return v;
+                if (entrada.cota == SUPERIOR && v <= alfa) return v;
+            }
+        }
+
+        Jugadas jugadas;
+        generarJugadas(jugadas);
+        ordenarJugadas(jugadas, jugadaTT);
+
+        int alfaOriginal = alfa;
+        int mejor = -INFINITO, mejorCasilla = -1;
+        for (int i = 0; i < jugadas.cantidad; i++) {
+            if (i == 1 && pool != nullptr && profundidad >= PROFUNDIDAD_DIVISION) {
+                dividir(jugadas, profundidad, alfa, beta, ply, mejor, mejorCasilla);
+                if (abortado) return 0;
+                break;
+            }
+            int casilla = jugadas.casillas[i];
+            colocar(casilla);
+            int v = -negamax(profundidad - 1, -beta, -alfa, ply + 1);
+            quitar(casilla);
+            if (abortado) return 0;
+
+            if (v > mejor) {
+                mejor = v;
+                mejorCasilla = casilla;
+            }
+            alfa = std::max(alfa, v);
+            if (alfa >= beta) {
+                premiarCorte(casilla, profundidad);
+                break;
+            }
+        }
+
+        entrada.valor = aTT(mejor, ply);
+        entrada.jugada = mejorCasilla;
+        entrada.profundidad = profundidad;
+        entrada.cota = (mejor <= alfaOriginal) ? SUPERIOR : (mejor >= beta) ? INFERIOR : EXACTO;
+        escribirTT(hash, entrada);
+        return mejor;
+    }
+
+    // Busca en paralelo los hijos 1..n-1 de este nodo (el primero ya se buscó
+    // y no cortó). Cada tarea parte del mejor alfa conocido al empezar; el
+    // primer hermano que llega a beta cancela al resto.
+    void dividir(const Jugadas& jugadas, int profundidad, int& alfa, int beta, int ply,
+                 int& mejor, int& mejorCasilla) {
+        struct Parcial {
+            int valor = 0;
+            long long nodos = 0;
+            bool abortado = true;
+        };
+        std::vector<Parcial> parciales(jugadas.cantidad);
+        Corte local;
+        local.padre = corte;
+        std::atomic<int> alfaCompartido{alfa};
+        PoolHilos::Grupo grupo;
+        // se lanzan al revés: el hilo dueño saca por el final y así empieza
+        // por la jugada mejor ordenada
+        for (int i = jugadas.cantidad - 1; i >= 1; i--) {
+            pool->lanzar(grupo, [&, i] {
+                MotorNxN ayudante(*this, &local);
+                // las tareas chicas no llegan a los 1024 nodos del control
+                // de tiempo: se mira al empezar
+                if (ayudante.debeParar()) return;
+                ayudante.colocar(jugadas.casillas[i]);
+                Parcial& p = parciales[i];
+                p.valor = -ayudante.negamax(profundidad - 1, -beta, -alfaCompartido.load(), ply + 1);
+                p.nodos = ayudante.nodos;
+                p.abortado = ayudante.abortado;
+                if (p.abortado) return;
+                subirAlfa(alfaCompartido, p.valor);
+                if (p.valor >= beta) local.cortado = true;
+            });
+        }
+        pool->esperar(grupo);
+
+        bool faltan = false;
+        for (int i = 1; i < jugadas.cantidad; i++) {
+            nodos += parciales[i].nodos;
+            if (parciales[i].abortado) {
+                faltan = true;
+                continue;
+            }
+            if (parciales[i].valor > mejor) {
+                mejor = parciales[i].valor;
+                mejorCasilla = jugadas.casillas[i];
+            }
+        }
+        alfa = std::max(alfa, mejor);
+        if (mejor >= beta) premiarCorte(mejorCasilla, profundidad);
+        // sin corte propio, un hermano sin terminar significa tiempo agotado
+        // o un corte más arriba
+        else if (faltan) abortado = true;
+    }
+
+    // Igual que en IA.cpp: las victorias se guardan medidas desde el nodo
+    static int aTT(int v, int ply) {
+        return v > GANA - CELDAS - 1 ? v + ply : v < -GANA + CELDAS + 1 ? v - ply : v;
+    }
+    static int desdeTT(int v, int ply) {
+        return v > GANA - CELDAS - 1 ? v - ply : v < -GANA + CELDAS + 1 ? v + ply : v;
+    }
+};
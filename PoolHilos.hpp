@@ -0,0 +1,148 @@
+// PoolHilos.hpp
+// Pool de hilos con robo de trabajo. Cada hilo tiene su propia cola: saca
+// sus tareas por el final (la más reciente, que suele tener los datos aún en
+// caché) y, cuando se queda sin trabajo, roba por el principio de la cola de
+// otro hilo (la más antigua, que suele ser la más grande). Esperar un grupo
+// de tareas no deja el hilo parado: mientras quedan pendientes ejecuta otras,
+// así que las tareas pueden lanzar y esperar subtareas sin interbloquearse.
+// Solo cuando no hay nada que ejecutar duerme, hasta que se encole otra
+// tarea o termine la última del grupo.
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PoolHilos {
+public:
+    // Tareas que se esperan juntas con esperar()
+    class Grupo {
+        friend class PoolHilos;
+        std::atomic<int> pendientes{0};
+    };
+
+    // hilos = 0 usa todos los núcleos
+    explicit PoolHilos(int hilos = 0) {
+        int n = hilos > 0 ? hilos : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        // la cola extra (índice n) recibe las tareas lanzadas desde fuera del pool
+        for (int i = 0; i <= n; i++) colas.push_back(std::make_unique<Cola>());
+        for (int i = 0; i < n; i++) trabajadores.emplace_back([this, i] { bucle(i); });
+    }
+
+    ~PoolHilos() {
+        {
+            std::lock_guard<std::mutex> lock(mutexDormir);
+            parar = true;
+        }
+        despertar.notify_all();
+        for (auto& t : trabajadores) t.join();
+    }
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    int tamano() const { return static_cast<int>(trabajadores.size()); }
+
+    void lanzar(Grupo& grupo, std::function<void()> tarea) {
+        grupo.pendientes.fetch_add(1, std::memory_order_relaxed);
+        int propia = (hiloActual().pool == this) ? hiloActual().indice : tamano();
+        {
+            std::lock_guard<std::mutex> lock(colas[propia]->mutex);
+            colas[propia]->tareas.push_back({std::move(tarea), &grupo});
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutexDormir);
+            enCola++;
+        }
+        despertar.notify_one();
+    }
+
+    // Vuelve cuando terminaron todas las tareas del grupo, ayudando mientras tanto
+    void esperar(Grupo& grupo) {
+        int propia = (hiloActual().pool == this) ? hiloActual().indice : tamano();
+        while (grupo.pendientes.load(std::memory_order_acquire) > 0) {
+            if (ejecutarUna(propia)) continue;
+            std::unique_lock<std::mutex> lock(mutexDormir);
+            despertar.wait(lock, [&] { return grupo.pendientes.load(std::memory_order_acquire) == 0 || enCola > 0; });
+        }
+    }
+
+private:
+    struct Tarea {
+        std::function<void()> funcion;
+        Grupo* grupo = nullptr;
+    };
+
+    struct Cola {
+        std::mutex mutex;
+        std::deque<Tarea> tareas;
+    };
+
+    struct HiloActual {
+        const PoolHilos* pool = nullptr;
+        int indice = 0;
+    };
+
+    static HiloActual& hiloActual() {
+        thread_local HiloActual h;
+        return h;
+    }
+
+    std::vector<std::unique_ptr<Cola>> colas;
+    std::vector<std::thread> trabajadores;
+    std::mutex mutexDormir;
+    std::condition_variable despertar;
+    int enCola = 0;   // tareas encoladas aún sin empezar, protegido por mutexDormir
+    bool parar = false;
+
+    bool sacar(int cola, bool delFinal, Tarea& tarea) {
+        std::lock_guard<std::mutex> lock(colas[cola]->mutex);
+        auto& tareas = colas[cola]->tareas;
+        if (tareas.empty()) return false;
+        if (delFinal) {
+            tarea = std::move(tareas.back());
+            tareas.pop_back();
+        } else {
+            tarea = std::move(tareas.front());
+            tareas.pop_front();
+        }
+        return true;
+    }
+
+    // Primero la cola propia por el final; si no, roba a los demás por el principio
+    bool ejecutarUna(int propia) {
+        Tarea tarea;
+        bool hay = sacar(propia, true, tarea);
+        for (int i = 1; !hay && i < static_cast<int>(colas.size()); i++)
+            hay = sacar((propia + i) % static_cast<int>(colas.size()), false, tarea);
+        if (!hay) return false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutexDormir);
+            enCola--;
+        }
+        tarea.funcion();
+        if (tarea.grupo->pendientes.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // era la última del grupo: despierta a quien lo espera. Tomar el
+            // mutex asegura que no está entre mirar el contador y dormirse.
+            { std::lock_guard<std::mutex> lock(mutexDormir); }
+            despertar.notify_all();
+        }
+        return true;
+    }
+
+    void bucle(int indice) {
+        hiloActual() = {this, indice};
+        while (true) {
+            if (ejecutarUna(indice)) continue;
+            std::unique_lock<std::mutex> lock(mutexDormir);
+            despertar.wait(lock, [this] { return parar || enCola > 0; });
+            if (parar) return;
+        }
+    }
+};
@@ -0,0 +1,84 @@
+// ProyeccionArchivo.hpp
+// Un archivo de solo lectura proyectado en memoria (mmap o, en Windows,
+// CreateFileMapping): el sistema lee las páginas a medida que se tocan y
+// leerlo no copia nada. Lo usan BaseDatos.hpp y RegistroPartidas.hpp.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class ProyeccionArchivo {
+public:
+    ProyeccionArchivo() = default;
+    ~ProyeccionArchivo() { cerrar(); }
+
+    ProyeccionArchivo(const ProyeccionArchivo&) = delete;
+    ProyeccionArchivo& operator=(const ProyeccionArchivo&) = delete;
+
+    // false si no existe, está vacío o no se pudo proyectar
+    bool abrir(const std::string& ruta) {
+        cerrar();
+#ifdef _WIN32
+        archivo = CreateFileA(ruta.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (archivo == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER largo;
+        if (!GetFileSizeEx(archivo, &largo) || largo.QuadPart == 0) {
+            cerrar();
+            return false;
+        }
+        tamanoArchivo = static_cast<std::size_t>(largo.QuadPart);
+        proyeccion = CreateFileMappingA(archivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (proyeccion != nullptr)
+            memoria = static_cast<const std::uint8_t*>(MapViewOfFile(proyeccion, FILE_MAP_READ, 0, 0, 0));
+#else
+        int fd = ::open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            tamanoArchivo = static_cast<std::size_t>(info.st_size);
+            void* p = mmap(nullptr, tamanoArchivo, PROT_READ, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED) memoria = static_cast<const std::uint8_t*>(p);
+        }
+        ::close(fd);   // la proyección sigue válida sin el descriptor
+#endif
+        if (memoria == nullptr) cerrar();
+        return memoria != nullptr;
+    }
+
+    void cerrar() {
+#ifdef _WIN32
+        if (memoria != nullptr) UnmapViewOfFile(memoria);
+        if (proyeccion != nullptr) CloseHandle(proyeccion);
+        if (archivo != INVALID_HANDLE_VALUE) CloseHandle(archivo);
+        proyeccion = nullptr;
+        archivo = INVALID_HANDLE_VALUE;
+#else
+        if (memoria != nullptr) munmap(const_cast<std::uint8_t*>(memoria), tamanoArchivo);
+#endif
+        memoria = nullptr;
+        tamanoArchivo = 0;
+    }
+
+    const std::uint8_t* datos() const { return memoria; }
+    std::size_t tamano() const { return tamanoArchivo; }
+
+private:
+    const std::uint8_t* memoria = nullptr;
+    std::size_t tamanoArchivo = 0;
+#ifdef _WIN32
+    HANDLE archivo = INVALID_HANDLE_VALUE;
+    HANDLE proyeccion = nullptr;
+#endif
+};
@@ -0,0 +1,229 @@
+// RegistroPartidas.hpp
+// Registro binario de partidas terminadas: un archivo que solo crece, con
+// una cabecera de 16 bytes y después un registro de 6 bytes por partida.
+//
+// Registro (48 bits, little endian):
+//   bits  0-35  jugadas: casilla de la jugada i en los bits 4i..4i+3
+//   bits 36-39  cantidad de jugadas (0-9)
+//   bits 40-41  resultado (ResultadoPartida)
+//   bit  42     contra la IA
+//   bits 43-45  dificultad (Difficulty)
+//   bits 46-47  sin uso
+//
+// EscritorRegistros junta los registros en memoria y los escribe desde su
+// propio hilo, así que agregar() solo toma un mutex un instante y nunca
+// espera al disco. LectorRegistros proyecta el archivo en memoria y
+// decodifica cada registro al leerlo, sin copiar ni interpretar texto.
+#pragma once
+#include "IA.hpp"
+#include "ProyeccionArchivo.hpp"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+enum class ResultadoPartida : std::uint8_t {
+    Empate = 0,
+    GanaX = 1,
+    GanaO = 2
+};
+
+struct CabeceraRegistro {
+    char magia[8];                     // "GATOREG" y un cero
+    std::uint8_t version = 1;
+    std::uint8_t bytesPorRegistro = 6;
+    std::uint8_t reservado[6] = {};
+};
+static_assert(sizeof(CabeceraRegistro) == 16, "la cabecera ocupa 16 bytes en disco");
+
+constexpr char MAGIA_REGISTRO[8] = {'G', 'A', 'T', 'O', 'R', 'E', 'G', '\0'};
+constexpr std::size_t BYTES_REGISTRO = 6;
+
+struct RegistroPartida {
+    std::array<std::uint8_t, 9> jugadas{};
+    int cantidad = 0;
+    ResultadoPartida resultado = ResultadoPartida::Empate;
+    bool vsIA = false;
+    Difficulty dificultad = Difficulty::Easy;
+
+    void agregarJugada(int casilla) {
+        if (cantidad < 9) jugadas[cantidad++] = static_cast<std::uint8_t>(casilla);
+    }
+
+    // Tablero después de las primeras `hasta` jugadas (X empieza)
+    Bitboard tablero(int hasta = 9) const {
+        TableroIncremental t;
+        for (int i = 0; i < cantidad && i < hasta; i++) t.colocar(jugadas[i]);
+        return t.b;
+    }
+
+    std::uint64_t empaquetar() const {
+        std::uint64_t bits = 0;
+        for (int i = 0; i < cantidad; i++) bits |= std::uint64_t(jugadas[i] & 0xF) << (4 * i);
+        bits |= std::uint64_t(cantidad) << 36;
+        bits |= std::uint64_t(resultado) << 40;
+        bits |= std::uint64_t(vsIA) << 42;
+        bits |= std::uint64_t(static_cast<int>(dificultad) & 7) << 43;
+        return bits;
+    }
+
+    static RegistroPartida desempaquetar(std::uint64_t bits) {
+        RegistroPartida r;
+        r.cantidad = std::min(9, static_cast<int>((bits >> 36) & 0xF));
+        for (int i = 0; i < r.cantidad; i++) r.jugadas[i] = static_cast<std::uint8_t>((bits >> (4 * i)) & 0xF);
+        r.resultado = static_cast<ResultadoPartida>((bits >> 40) & 3);
+        r.vsIA = ((bits >> 42) & 1) != 0;
+        r.dificultad = static_cast<Difficulty>((bits >> 43) & 7);
+        return r;
+    }
+};
+
+class EscritorRegistros {
+public:
+    // Abre (o crea) el archivo para agregar al final; si ya existe tiene que
+    // tener una cabecera válida
+    explicit EscritorRegistros(const std::string& ruta) {
+        archivo = std::fopen(ruta.c_str(), "a+b");
+        if (archivo == nullptr) return;
+
+        std::fseek(archivo, 0, SEEK_END);
+        if (std::ftell(archivo) == 0) {
+            CabeceraRegistro cabecera;
+            std::memcpy(cabecera.magia, MAGIA_REGISTRO, sizeof(MAGIA_REGISTRO));
+            bool ok = std::fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1 && std::fflush(archivo) == 0;
+            if (!ok) cerrarArchivo();
+        } else {
+            CabeceraRegistro cabecera;
+            std::fseek(archivo, 0, SEEK_SET);
+            bool valida = std::fread(&cabecera, sizeof(cabecera), 1, archivo) == 1 &&
+                          std::memcmp(cabecera.magia, MAGIA_REGISTRO, sizeof(MAGIA_REGISTRO)) == 0 &&
+                          cabecera.bytesPorRegistro == BYTES_REGISTRO;
+            // entre leer y escribir el estándar exige reposicionar el archivo
+            valida = valida && std::fseek(archivo, 0, SEEK_END) == 0;
+            // un registro a medio escribir (programa cortado) se recorta:
+            // si no, todo lo que se agregue después quedaría desalineado
+            long tamano = valida ? std::ftell(archivo) : -1;
+            long sobra = (tamano - static_cast<long>(sizeof(CabeceraRegistro))) % static_cast<long>(BYTES_REGISTRO);
+            if (valida && sobra != 0) {
+                valida = recortar(tamano - sobra) && std::fseek(archivo, 0, SEEK_END) == 0;
+            }
+            if (!valida) cerrarArchivo();
+        }
+        if (archivo != nullptr) hilo = std::thread([this] { bucle(); });
+    }
+
+    // Escribe lo que quede pendiente antes de cerrar
+    ~EscritorRegistros() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            parar = true;
+        }
+        hayTrabajo.notify_one();
+        if (hilo.joinable()) hilo.join();
+        cerrarArchivo();
+    }
+
+    EscritorRegistros(const EscritorRegistros&) = delete;
+    EscritorRegistros& operator=(const EscritorRegistros&) = delete;
+
+    bool abierto() const { return archivo != nullptr; }
+
+    void agregar(const RegistroPartida& registro) {
+        if (archivo == nullptr) return;
+        std::uint64_t bits = registro.empaquetar();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (std::size_t i = 0; i < BYTES_REGISTRO; i++)
+                pendientes.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+        }
+        hayTrabajo.notify_one();
+    }
+
+private:
+    std::FILE* archivo = nullptr;
+    std::thread hilo;
+    std::mutex mutex;
+    std::condition_variable hayTrabajo;
+    std::vector<std::uint8_t> pendientes;
+    bool parar = false;
+
+    bool recortar(long tamano) {
+        if (std::fflush(archivo) != 0) return false;
+#ifdef _WIN32
+        return _chsize_s(_fileno(archivo), tamano) == 0;
+#else
+        return ftruncate(fileno(archivo), tamano) == 0;
+#endif
+    }
+
+    void cerrarArchivo() {
+        if (archivo != nullptr) std::fclose(archivo);
+        archivo = nullptr;
+    }
+
+    // Se lleva todo lo pendiente de una vez (intercambiando los vectores) y
+    // escribe sin el mutex tomado
+    void bucle() {
+        std::vector<std::uint8_t> lote;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                hayTrabajo.wait(lock, [this] { return parar || !pendientes.empty(); });
+                if (pendientes.empty()) return;   // parar y nada pendiente
+                lote.swap(pendientes);
+            }
+            // en modo "a" toda escritura va al final
+            std::fwrite(lote.data(), 1, lote.size(), archivo);
+            std::fflush(archivo);
+            lote.clear();
+        }
+    }
+};
+
+class LectorRegistros {
+public:
+    // false si no existe o no es un registro de partidas
+    bool abrir(const std::string& ruta) {
+        cantidad = 0;
+        if (!archivo.abrir(ruta)) return false;
+        CabeceraRegistro cabecera;
+        bool valida = archivo.tamano() >= sizeof(CabeceraRegistro);
+        if (valida) {
+            std::memcpy(&cabecera, archivo.datos(), sizeof(CabeceraRegistro));
+            valida = std::memcmp(cabecera.magia, MAGIA_REGISTRO, sizeof(MAGIA_REGISTRO)) == 0 &&
+                     cabecera.bytesPorRegistro == BYTES_REGISTRO;
+        }
+        if (!valida) {
+            archivo.cerrar();
+            return false;
+        }
+        // un registro a medio escribir al final (programa cortado) se ignora
+        cantidad = (archivo.tamano() - sizeof(CabeceraRegistro)) / BYTES_REGISTRO;
+        return true;
+    }
+
+    std::size_t size() const { return cantidad; }
+
+    RegistroPartida operator[](std::size_t i) const {
+        const std::uint8_t* p = archivo.datos() + sizeof(CabeceraRegistro) + i * BYTES_REGISTRO;
+        std::uint64_t bits = 0;
+        for (std::size_t b = 0; b < BYTES_REGISTRO; b++) bits |= std::uint64_t(p[b]) << (8 * b);
+        return RegistroPartida::desempaquetar(bits);
+    }
+
+private:
+    ProyeccionArchivo archivo;
+    std::size_t cantidad = 0;
+};
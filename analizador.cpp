@@ -0,0 +1,160 @@
+// analizador.cpp
+// Analiza posiciones sin interfaz: lee un flujo de posiciones de un archivo
+// o de la entrada estándar y escribe, para cada una y en el mismo orden, su
+// valor, la mejor jugada y los nodos buscados. Las posiciones se leen por
+// bloques y cada bloque se reparte entre los hilos de un PoolHilos.
+//
+// Uso: analizador [archivo|-] [texto|binario] [hilos]
+//   texto:   una posición por línea, 9 caracteres X, O o '.' fila por fila;
+//            las líneas vacías y las que empiezan con # se ignoran
+//   binario: 4 bytes por posición, máscaras de X y de O (uint16 little endian)
+// Salida: "tablero valor jugada nodos" por posición. El valor es desde el
+// punto de vista del bando al que le toca: 10 - jugadas si gana, jugadas - 10
+// si pierde, 0 si es empate. En posiciones terminadas la jugada es -1; las
+// inválidas se marcan "invalido".
+#include "IA.hpp"
+#include "PoolHilos.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+constexpr std::size_t TAMANO_BLOQUE = 4096;
+
+struct Registro {
+    Bitboard b;
+    bool valido = false;
+    char texto[10] = {};   // el tablero como se escribe en la salida
+};
+
+bool tableroValido(const Bitboard& b) {
+    if ((b.x | b.o) > TABLERO_COMPLETO || (b.x & b.o) != 0) return false;
+    int diferencia = std::popcount(b.x) - std::popcount(b.o);
+    if (diferencia != 0 && diferencia != 1) return false;
+    // la línea tiene que ser de quien jugó último
+    if (tieneLinea(b.x) && diferencia != 1) return false;
+    return !(tieneLinea(b.o) && diferencia != 0);
+}
+
+// Lee hasta TAMANO_BLOQUE registros; devuelve false al final del flujo
+bool leerBloque(FILE* entrada, bool binario, std::vector<Registro>& bloque) {
+    bloque.clear();
+    if (binario) {
+        std::uint8_t bytes[4];
+        while (bloque.size() < TAMANO_BLOQUE && std::fread(bytes, 1, 4, entrada) == 4) {
+            Registro r;
+            r.b.x = static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+            r.b.o = static_cast<std::uint16_t>(bytes[2] | (bytes[3] << 8));
+            r.valido = tableroValido(r.b);
+            for (int i = 0; i < 9; i++) r.texto[i] = (r.b.x >> i & 1) ? 'X' : (r.b.o >> i & 1) ? 'O' : '.';
+            bloque.push_back(r);
+        }
+        return !bloque.empty();
+    }
+
+    char linea[256];
+    while (bloque.size() < TAMANO_BLOQUE && std::fgets(linea, sizeof(linea), entrada)) {
+        std::size_t largo = std::strcspn(linea, "\r\n");
+        if (largo == 0 || linea[0] == '#') continue;
+        Registro r;
+        r.valido = (largo == 9);
+        std::memcpy(r.texto, linea, std::min<std::size_t>(largo, 9));
+        for (std::size_t i = 0; r.valido && i < 9; i++) {
+            char c = linea[i];
+            if (c == 'X' || c == 'x') r.b.x |= static_cast<std::uint16_t>(1u << i);
+            else if (c == 'O' || c == 'o') r.b.o |= static_cast<std::uint16_t>(1u << i);
+            else if (c != '.' && c != '-') r.valido = false;
+        }
+        if (r.valido)
+            for (int i = 0; i < 9; i++) r.texto[i] = r.b.get(i / 3, i % 3) == ' ' ? '.' : r.b.get(i / 3, i % 3);
+        r.valido = r.valido && tableroValido(r.b);
+        bloque.push_back(r);
+    }
+    return !bloque.empty();
+}
+
+// Agrega la línea de resultado de una posición a la salida del tramo
+void analizar(const Registro& r, ContextoIA& ctx, std::string& salida) {
+    const char* texto = r.texto;
+    char linea[64];
+    if (!r.valido) {
+        std::snprintf(linea, sizeof(linea), "%s invalido\n", texto);
+        salida += linea;
+        return;
+    }
+
+    int signo = (r.b.turno() == 'O') ? 1 : -1;   // minimax mide desde O
+    TableroIncremental t(r.b);
+    if (t.terminado()) {
+        std::snprintf(linea, sizeof(linea), "%s %d -1 0\n", texto, signo * t.valor());
+    } else {
+        // tabla limpia en cada posición: los nodos no dependen de qué otras
+        // posiciones le tocaron al mismo hilo
+        ctx.tt.limpiar();
+        ctx.nodos = 0;
+        int valor;
+        int jugada = buscarJugada(r.b, ctx, valor);
+        std::snprintf(linea, sizeof(linea), "%s %d %d %lld\n", texto, signo * valor, jugada, ctx.nodos);
+    }
+    salida += linea;
+}
+
+int main(int argc, char** argv) {
+    std::string ruta = (argc > 1) ? argv[1] : "-";
+    std::string formato = (argc > 2) ? argv[2] : "texto";
+    int hilos = (argc > 3) ? std::max(1, std::atoi(argv[3])) : 0;
+    if (formato != "texto" && formato != "binario") {
+        std::fprintf(stderr, "Uso: analizador [archivo|-] [texto|binario] [hilos]\n");
+        return 1;
+    }
+    bool binario = (formato == "binario");
+
+    FILE* entrada = stdin;
+    if (ruta != "-") {
+        entrada = std::fopen(ruta.c_str(), binario ? "rb" : "r");
+        if (entrada == nullptr) {
+            std::fprintf(stderr, "No se pudo abrir %s\n", ruta.c_str());
+            return 1;
+        }
+    }
+#ifdef _WIN32
+    else if (binario) {
+        _setmode(_fileno(stdin), _O_BINARY);
+    }
+#endif
+
+    PoolHilos pool(hilos);
+    int tramos = pool.tamano();
+    std::vector<ContextoIA> contextos;
+    contextos.reserve(tramos);
+    for (int i = 0; i < tramos; i++) contextos.emplace_back(static_cast<std::uint32_t>(i + 1));
+    std::vector<std::string> salidas(tramos);
+
+    std::vector<Registro> bloque;
+    while (leerBloque(entrada, binario, bloque)) {
+        std::size_t porTramo = (bloque.size() + tramos - 1) / tramos;
+        PoolHilos::Grupo grupo;
+        for (int h = 0; h < tramos; h++) {
+            pool.lanzar(grupo, [&, h] {
+                salidas[h].clear();
+                std::size_t desde = h * porTramo, hasta = std::min(bloque.size(), desde + porTramo);
+                for (std::size_t i = desde; i < hasta; i++) analizar(bloque[i], contextos[h], salidas[h]);
+            });
+        }
+        pool.esperar(grupo);
+
+        // los tramos se escriben en orden: la salida sigue el orden de entrada
+        for (const std::string& s : salidas) std::fwrite(s.data(), 1, s.size(), stdout);
+    }
+
+    if (entrada != stdin) std::fclose(entrada);
+    return 0;
+}
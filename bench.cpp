@@ -0,0 +1,507 @@
+// bench.cpp
+// Microbenchmarks de las rutas calientes del motor: evaluar(), tableroLleno(),
+// movimientosDisponibles(), minimax() desde varias posiciones, cpuMedium(),
+// jugadaYFinNucleo() (la réplica sin SFML de lo que hace gato.cpp en cada
+// jugada, no su checkWinner()), MotorNxN y MCTS.
+// Reporta ns/op, nodos/s (búsquedas) y reservas de memoria por operación.
+//
+// Uso: bench [escala]   (escala multiplica las iteraciones, por defecto 1)
+//      bench perft [tablero] [repeticiones]
+//        tablero: 9 caracteres X, O o '.', fila por fila (por defecto vacío).
+//        Desde el tablero vacío además comprueba los totales conocidos.
+//      bench simd
+//        Compara evaluarLote() con evaluar() en todos los pares de máscaras
+//        con cada núcleo disponible y mide su rendimiento.
+//      bench reservas
+//        Falla (código 1) si movimientosDisponibles(), minimax() o cpuMedium()
+//        reservan memoria.
+//      bench base [archivo]   (por defecto base_4x4_k3.bin, de solver)
+//        Falla (código 1) si MotorNxN con la base busca o no juega perfecto
+//        en alguna posición alcanzable.
+#include "EvaluacionSIMD.hpp"
+#include "IA.hpp"
+#include "MotorNxN.hpp"
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Contador de reservas: reemplaza las formas globales de operator new y
+// delete de este ejecutable (simples, de arreglo, con tamaño y alineadas).
+// Todas pasan por reservar() y liberar(), que no se expanden en línea: así
+// el compilador no ve nunca un free() frente a un operator new y no avisa
+// de reservas y liberaciones que no coinciden.
+static long long reservas = 0;
+
+[[gnu::noinline]] static void* reservar(std::size_t n, std::size_t alineacion) {
+    reservas++;
+    n = n ? n : 1;
+    void* p = nullptr;
+    if (alineacion <= alignof(std::max_align_t)) {
+        p = std::malloc(n);
+    } else {
+#ifdef _WIN32
+        p = _aligned_malloc(n, alineacion);
+#else
+        if (posix_memalign(&p, alineacion, n) != 0) p = nullptr;
+#endif
+    }
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+[[gnu::noinline]] static void liberar(void* p, std::size_t alineacion) noexcept {
+#ifdef _WIN32
+    if (alineacion > alignof(std::max_align_t)) {
+        _aligned_free(p);
+        return;
+    }
+#endif
+    (void)alineacion;
+    std::free(p);
+}
+
+constexpr std::size_t SIN_ALINEAR = alignof(std::max_align_t);
+
+void* operator new(std::size_t n) { return reservar(n, SIN_ALINEAR); }
+void* operator new[](std::size_t n) { return reservar(n, SIN_ALINEAR); }
+void* operator new(std::size_t n, std::align_val_t a) { return reservar(n, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t n, std::align_val_t a) { return reservar(n, static_cast<std::size_t>(a)); }
+
+void operator delete(void* p) noexcept { liberar(p, SIN_ALINEAR); }
+void operator delete[](void* p) noexcept { liberar(p, SIN_ALINEAR); }
+void operator delete(void* p, std::size_t) noexcept { liberar(p, SIN_ALINEAR); }
+void operator delete[](void* p, std::size_t) noexcept { liberar(p, SIN_ALINEAR); }
+void operator delete(void* p, std::align_val_t a) noexcept { liberar(p, static_cast<std::size_t>(a)); }
+void operator delete[](void* p, std::align_val_t a) noexcept { liberar(p, static_cast<std::size_t>(a)); }
+void operator delete(void* p, std::size_t, std::align_val_t a) noexcept { liberar(p, static_cast<std::size_t>(a)); }
+void operator delete[](void* p, std::size_t, std::align_val_t a) noexcept { liberar(p, static_cast<std::size_t>(a)); }
+
+// Evita que el compilador descarte los resultados medidos
+volatile int sumidero = 0;
+
+using Reloj = std::chrono::steady_clock;
+
+void reportar(const char* nombre, double ns, long long ops, long long reservasTotales, double nodosPorSeg = 0) {
+    printf("%-34s %12.2f ns/op", nombre, ns / ops);
+    if (nodosPorSeg > 0) printf(" %12.0f nodos/s", nodosPorSeg);
+    else printf(" %20s", "");
+    printf(" %8.2f allocs/op\n", static_cast<double>(reservasTotales) / ops);
+}
+
+// Mide f(posicion) recorriendo el conjunto de posiciones varias veces
+template <class T, class F>
+void medirLote(const char* nombre, const std::vector<T>& posiciones, long long iteraciones, F f) {
+    long long reservasAntes = reservas;
+    auto inicio = Reloj::now();
+    int acumulado = 0;
+    for (long long i = 0; i < iteraciones; i++)
+        acumulado += f(posiciones[i % posiciones.size()]);
+    double ns = std::chrono::duration<double, std::nano>(Reloj::now() - inicio).count();
+    sumidero = sumidero + acumulado;
+    reportar(nombre, ns, iteraciones, reservas - reservasAntes);
+}
+
+// Mide una búsqueda minimax completa desde la raíz. Con tablaFria la tabla
+// de transposición se vacía antes de cada búsqueda (fuera del tiempo medido).
+// Reporta también los aciertos, fallos y guardados de la tabla.
+void medirMinimax(const char* nombre, Bitboard raiz, long long repeticiones, bool tablaFria) {
+    ContextoIA ctx(1);
+    double ns = 0;
+    long long reservasMedidas = 0;
+    int acumulado = 0;
+    EstadisticasTT tt;
+    auto sumarTT = [&tt, &ctx] {
+        tt.aciertos += ctx.tt.stats.aciertos;
+        tt.fallos += ctx.tt.stats.fallos;
+        tt.guardados += ctx.tt.stats.guardados;
+    };
+    for (long long i = 0; i < repeticiones; i++) {
+        if (tablaFria) {
+            sumarTT();   // limpiar() también pone los contadores en cero
+            ctx.tt.limpiar();
+        }
+        TableroIncremental b(raiz);
+        long long reservasAntes = reservas;
+        auto inicio = Reloj::now();
+        acumulado += minimax(b, 0, -1000, 1000, raiz.turno() == 'O', ctx);
+        ns += std::chrono::duration<double, std::nano>(Reloj::now() - inicio).count();
+        reservasMedidas += reservas - reservasAntes;
+    }
+    sumarTT();
+    sumidero = sumidero + acumulado;
+    reportar(nombre, ns, repeticiones, reservasMedidas, ctx.nodos / (ns * 1e-9));
+    long long consultas = tt.aciertos + tt.fallos;
+    printf("%34s tabla: %.1f%% aciertos (%lld de %lld), %lld guardados\n", "",
+           consultas > 0 ? 100.0 * tt.aciertos / consultas : 0.0, tt.aciertos, consultas, tt.guardados);
+}
+
+// Partida completa del motor N x N contra sí mismo con presupuesto fijo por
+// jugada: reporta la jugada más lenta y los nodos por segundo. Con pool la
+// búsqueda se reparte entre sus hilos.
+template <int N, int K>
+void medirMotorNxN(const char* nombre, std::chrono::milliseconds presupuesto, PoolHilos* pool = nullptr) {
+    MotorNxN<N, K> motor;
+    double ns = 0, peorMs = 0;
+    long long nodos = 0, jugadas = 0, reservasAntes = reservas;
+    while (!motor.terminado()) {
+        auto inicio = Reloj::now();
+        auto res = motor.buscar(presupuesto, 64, pool);
+        double d = std::chrono::duration<double, std::nano>(Reloj::now() - inicio).count();
+        ns += d;
+        peorMs = std::max(peorMs, d * 1e-6);
+        nodos += res.nodos;
+        jugadas++;
+        motor.colocar(res.casilla);
+    }
+    reportar(nombre, ns, jugadas, reservas - reservasAntes, nodos / (ns * 1e-9));
+    printf("%34s peor jugada %.1f ms (presupuesto %lld ms), %lld jugadas\n", "",
+           peorMs, static_cast<long long>(presupuesto.count()), jugadas);
+}
+
+// Búsqueda MCTS desde el tablero vacío con un hilo y con todos los núcleos:
+// reporta partidas aleatorias por segundo
+void medirMCTS(const char* nombre, long long partidas, int hilos) {
+    ContextoIA ctx(3);
+    ctx.mcts.partidas = partidas;
+    ctx.mcts.hilos = hilos;
+    long long reservasAntes = reservas;
+    auto inicio = Reloj::now();
+    sumidero = sumidero + elegirMovimiento(Bitboard{}, Difficulty::MCTS, ctx);
+    double ns = std::chrono::duration<double, std::nano>(Reloj::now() - inicio).count();
+    reportar(nombre, ns, ctx.ultimoMCTS.partidas, reservas - reservasAntes);
+    printf("%34s %.0f partidas/s\n", "", ctx.ultimoMCTS.partidasPorSegundo);
+}
+
+// Lo que hace la partida en gato.cpp por cada jugada, sin la parte de SFML:
+// colocar en el tablero incremental y leer si terminó (más quitar, para
+// volver a la posición medida)
+int jugadaYFinNucleo(TableroIncremental& t) {
+    int casilla = std::countr_zero(t.b.libres());
+    t.colocar(casilla);
+    int fin = (t.linea >= 0) ? 1 : t.lleno() ? 2 : 0;
+    t.quitar(casilla);
+    return fin;
+}
+
+// Posiciones alcanzables sin terminar, de partidas aleatorias reproducibles
+std::vector<Bitboard> generarPosiciones(int cantidad) {
+    std::mt19937 rng(2024);
+    std::vector<Bitboard> posiciones;
+    while (static_cast<int>(posiciones.size()) < cantidad) {
+        Bitboard b;
+        while (!tieneLinea(b.x) && !tieneLinea(b.o) && b.ocupadas() != TABLERO_COMPLETO) {
+            posiciones.push_back(b);
+            auto movs = movimientosDisponibles(b);
+            int casilla = movs[rng() % movs.size()];
+            b.set(casilla / 3, casilla % 3, b.turno());
+        }
+    }
+    posiciones.resize(cantidad);
+    return posiciones;
+}
+
+// evaluarLote() con un núcleo dado sobre el mismo lote varias veces
+void medirEvaluarLote(NucleoSIMD nucleo, const LotePosiciones& lote, int repeticiones) {
+    std::vector<std::int8_t> resultados;
+    evaluarLote(lote, resultados, nucleo);   // reserva fuera de la medición
+    long long reservasAntes = reservas;
+    auto inicio = Reloj::now();
+    int acumulado = 0;
+    for (int r = 0; r < repeticiones; r++) {
+        evaluarLote(lote, resultados, nucleo);
+        acumulado += resultados[r % resultados.size()];
+    }
+    double ns = std::chrono::duration<double, std::nano>(Reloj::now() - inicio).count();
+    sumidero = sumidero + acumulado;
+    long long posiciones = static_cast<long long>(lote.size()) * repeticiones;
+    std::string nombre = std::string("evaluarLote() ") + nombreNucleo(nucleo);
+    reportar(nombre.c_str(), ns, posiciones, reservas - reservasAntes);
+    printf("%34s %.0f millones de posiciones/s\n", "", posiciones / ns * 1e3);
+}
+
+std::vector<NucleoSIMD> nucleosDisponibles() {
+    std::vector<NucleoSIMD> nucleos = {NucleoSIMD::Escalar};
+    if (nucleoDisponible() >= NucleoSIMD::SSE4) nucleos.push_back(NucleoSIMD::SSE4);
+    if (nucleoDisponible() >= NucleoSIMD::AVX2) nucleos.push_back(NucleoSIMD::AVX2);
+    return nucleos;
+}
+
+// Paridad exacta con evaluar(): los 2^18 pares de máscaras, también los
+// imposibles (casillas de los dos, dos líneas), más una cola que no llena
+// un registro para probar el tramo escalar
+int modoSIMD() {
+    LotePosiciones lote;
+    for (int x = 0; x < 512; x++)
+        for (int o = 0; o < 512; o++) lote.agregar(Bitboard{std::uint16_t(x), std::uint16_t(o)});
+    for (int i = 0; i < 13; i++) lote.agregar(Bitboard{std::uint16_t(0x007 + i), std::uint16_t(0x1C0 - i)});
+
+    printf("Nucleo de la CPU: %s\n", nombreNucleo(nucleoDisponible()));
+    bool ok = true;
+    std::vector<std::int8_t> resultados;
+    for (NucleoSIMD nucleo : nucleosDisponibles()) {
+        evaluarLote(lote, resultados, nucleo);
+        long long distintas = 0;
+        for (std::size_t i = 0; i < lote.size(); i++)
+            if (resultados[i] != evaluar(Bitboard{lote.x[i], lote.o[i]})) distintas++;
+        printf("  %-8s %zu posiciones, %lld distintas de evaluar()\n", nombreNucleo(nucleo), lote.size(), distintas);
+        ok = ok && distintas == 0;
+    }
+    printf("\n");
+
+    LotePosiciones reales;
+    for (const Bitboard& b : generarPosiciones(1 << 20)) reales.agregar(b);
+    for (NucleoSIMD nucleo : nucleosDisponibles()) medirEvaluarLote(nucleo, reales, 50);
+
+    printf("\n%s\n", ok ? "OK: todos los nucleos coinciden con evaluar()" : "ERROR: hay diferencias con evaluar()");
+    return ok ? 0 : 1;
+}
+
+// Reservas hechas por f(posicion) sobre todas las posiciones
+template <class F>
+bool sinReservas(const char* nombre, const std::vector<Bitboard>& posiciones, F f) {
+    long long reservasAntes = reservas;
+    int acumulado = 0;
+    for (const Bitboard& b : posiciones) acumulado += f(b);
+    sumidero = sumidero + acumulado;
+    long long hechas = reservas - reservasAntes;
+    printf("  %-34s %lld reservas\n", nombre, hechas);
+    return hechas == 0;
+}
+
+// Generar jugadas y buscar no reservan memoria: falla si alguna de estas
+// funciones llega a operator new. El contexto y las posiciones se crean
+// antes de contar.
+int modoReservas() {
+    std::vector<Bitboard> posiciones = generarPosiciones(4096);
+    ContextoIA ctx(7);
+
+    printf("Reservas de memoria en %zu posiciones\n", posiciones.size());
+    bool ok = true;
+    ok &= sinReservas("movimientosDisponibles()", posiciones, [](const Bitboard& b) {
+        return movimientosDisponibles(b).size();
+    });
+    ok &= sinReservas("minimax(), tabla fria", posiciones, [&ctx](const Bitboard& b) {
+        ctx.tt.limpiar();
+        TableroIncremental t(b);
+        return minimax(t, 0, -1000, 1000, b.turno() == 'O', ctx);
+    });
+    ok &= sinReservas("minimax(), tabla caliente", posiciones, [&ctx](const Bitboard& b) {
+        TableroIncremental t(b);
+        return minimax(t, 0, -1000, 1000, b.turno() == 'O', ctx);
+    });
+    ok &= sinReservas("cpuMedium()", posiciones, [&ctx](const Bitboard& b) { return cpuMedium(b, ctx); });
+
+    printf("\n%s\n", ok ? "OK: ninguna reserva" : "ERROR: generar jugadas o buscar reservo memoria");
+    return ok ? 0 : 1;
+}
+
+// Recorrido de todas las posiciones alcanzables (cada una una vez) para
+// comprobar la jugada de MotorNxN con la base
+struct ComprobacionBase {
+    BaseDatos& base;
+    std::vector<std::uint32_t> potencias;
+    std::vector<bool> vistas;
+    long long posiciones = 0;
+    long long errores = 0;
+    long long distintasIA = 0;   // solo 3x3: distinta de la tabla de IA.cpp
+};
+
+template <int N, int K>
+void recorrerBase(MotorNxN<N, K>& motor, std::uint32_t codigo, ComprobacionBase& c) {
+    if (c.vistas[codigo]) return;
+    c.vistas[codigo] = true;
+    if (motor.terminado()) return;
+    c.posiciones++;
+
+    // La jugada tiene que salir de la base sin buscar y llevar a un hijo
+    // que conserve el valor de la posición a una jugada menos del final
+    ValorBase valor = c.base.valor(codigo);
+    int distancia = c.base.distancia(codigo);
+    auto res = motor.buscar(std::chrono::milliseconds(1000));
+    bool ok = res.nodos == 0 && res.casilla >= 0 && motor.get(res.casilla) == MotorNxN<N, K>::VACIA;
+    if (ok) {
+        std::uint32_t hijo = codigo + motor.turno() * c.potencias[res.casilla];
+        ValorBase valorHijo = c.base.valor(hijo);
+        int distanciaHijo = c.base.distancia(hijo);
+        if (valor == ValorBase::Gana) ok = valorHijo == ValorBase::Pierde && distanciaHijo == distancia - 1;
+        else if (valor == ValorBase::Pierde) ok = valorHijo == ValorBase::Gana && distanciaHijo == distancia - 1;
+        else ok = valor == ValorBase::Empate && valorHijo == ValorBase::Empate;
+    }
+    if (!ok) c.errores++;
+
+    if constexpr (N == 3 && K == 3) {
+        // valorPerfecto() es desde O: 10 - distancia si gana O
+        Bitboard b = tableroDeCodigo(static_cast<int>(codigo));
+        int v = valorPerfecto(b);
+        if (b.turno() == 'X') v = -v;
+        int esperado = (v > 0) ? 10 - v : (v < 0) ? 10 + v : -1;
+        ValorBase valorIA = (v > 0) ? ValorBase::Gana : (v < 0) ? ValorBase::Pierde : ValorBase::Empate;
+        if (valor != valorIA || (v != 0 && distancia != esperado)) c.distintasIA++;
+    }
+
+    for (int casilla = 0; casilla < N * N; casilla++) {
+        if (motor.get(casilla) != MotorNxN<N, K>::VACIA) continue;
+        std::uint32_t hijo = codigo + motor.turno() * c.potencias[casilla];
+        motor.colocar(casilla);
+        recorrerBase(motor, hijo, c);
+        motor.quitar(casilla);
+    }
+}
+
+template <int N, int K>
+bool comprobarBase(BaseDatos& base) {
+    ComprobacionBase c{base, {}, {}};
+    for (std::uint32_t p = 1, i = 0; i < N * N; i++, p *= 3) c.potencias.push_back(p);
+    c.vistas.assign(std::size_t(c.potencias.back()) * 3, false);
+    MotorNxN<N, K> motor;
+    motor.usarBase(&base);
+
+    auto inicio = Reloj::now();
+    recorrerBase(motor, 0, c);
+    double segundos = std::chrono::duration<double>(Reloj::now() - inicio).count();
+
+    printf("Base %dx%d, %d en linea: %lld posiciones en %.2f s\n", N, N, K, c.posiciones, segundos);
+    printf("  %lld jugadas que buscaron o no fueron perfectas\n", c.errores);
+    if (N == 3 && K == 3) printf("  %lld posiciones distintas de la tabla de IA.cpp\n", c.distintasIA);
+    return c.errores == 0 && c.distintasIA == 0;
+}
+
+int modoBase(int argc, char** argv) {
+    BaseDatos base((argc > 2) ? argv[2] : "base_4x4_k3.bin");
+    if (!base.disponible()) {
+        printf("No se pudo abrir la base: generala con solver\n");
+        return 1;
+    }
+    if (base.distancia(0) < 0) {
+        printf("La base no guarda distancias: vuelve a generarla con solver\n");
+        return 1;
+    }
+    bool ok;
+    if (base.coincide(3, 3)) ok = comprobarBase<3, 3>(base);
+    else if (base.coincide(4, 3)) ok = comprobarBase<4, 3>(base);
+    else if (base.coincide(4, 4)) ok = comprobarBase<4, 4>(base);
+    else {
+        printf("Tablero %dx%d con %d en linea: no soportado aqui\n", base.n(), base.n(), base.k());
+        return 1;
+    }
+    printf("\n%s\n", ok ? "OK: MotorNxN juega perfecto desde la base sin buscar"
+                         : "ERROR: MotorNxN no juega perfecto desde la base");
+    return ok ? 0 : 1;
+}
+
+// "X.O......" -> Bitboard; false si el texto no es un tablero
+bool leerTablero(const std::string& texto, Bitboard& b) {
+    if (texto.size() != 9) return false;
+    for (int i = 0; i < 9; i++) {
+        char c = texto[i];
+        if (c == 'X' || c == 'x') b.set(i / 3, i % 3, 'X');
+        else if (c == 'O' || c == 'o') b.set(i / 3, i % 3, 'O');
+        else if (c != '.' && c != '-') return false;
+    }
+    int diferencia = std::popcount(b.x) - std::popcount(b.o);
+    return diferencia == 0 || diferencia == 1;
+}
+
+int modoPerft(int argc, char** argv) {
+    Bitboard raiz;
+    if (argc > 2 && !leerTablero(argv[2], raiz)) {
+        printf("Tablero invalido: usa 9 caracteres X, O o '.'\n");
+        return 1;
+    }
+    long long repeticiones = (argc > 3) ? std::max(1LL, std::atoll(argv[3])) : 20;
+
+    ResultadoPerft r;
+    auto inicio = Reloj::now();
+    for (long long i = 0; i < repeticiones; i++) {
+        r = ResultadoPerft{};
+        TableroIncremental t(raiz);
+        perft(t, r);
+    }
+    double segundos = std::chrono::duration<double>(Reloj::now() - inicio).count();
+
+    printf("Perft desde %s\n", argc > 2 ? argv[2] : ".........");
+    printf("  Nodos:    %lld\n", r.nodos);
+    printf("  Partidas: %lld (gana X %lld, gana O %lld, empates %lld)\n", r.partidas, r.ganaX, r.ganaO, r.empates);
+    printf("  %.3f ms por recorrido, %.0f nodos/s\n", 1e3 * segundos / repeticiones, r.nodos * repeticiones / segundos);
+
+    if (raiz == Bitboard{}) {
+        bool ok = r.nodos == 549946 && r.partidas == 255168 && r.ganaX == 131184 && r.ganaO == 77904 &&
+                  r.empates == 46080;
+        printf("  %s\n", ok ? "OK: coincide con los totales conocidos" : "ERROR: no coincide con los totales conocidos");
+        return ok ? 0 : 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "perft") return modoPerft(argc, argv);
+    if (argc > 1 && std::string(argv[1]) == "simd") return modoSIMD();
+    if (argc > 1 && std::string(argv[1]) == "reservas") return modoReservas();
+    if (argc > 1 && std::string(argv[1]) == "base") return modoBase(argc, argv);
+
+    long long escala = (argc > 1) ? std::max(1LL, std::atoll(argv[1])) : 1;
+    const long long N = 20000000 * escala;
+
+    std::vector<Bitboard> posiciones = generarPosiciones(4096);
+    ContextoIA ctx(7);
+
+    printf("Benchmark del motor (escala %lld)\n\n", escala);
+
+    medirLote("evaluar()", posiciones, N, [](const Bitboard& b) { return evaluar(b); });
+    medirLote("tableroLleno()", posiciones, N, [](const Bitboard& b) { return tableroLleno(b) ? 1 : 0; });
+    medirLote("movimientosDisponibles()", posiciones, N, [](const Bitboard& b) {
+        return movimientosDisponibles(b).size();
+    });
+    std::vector<TableroIncremental> incrementales;
+    for (const Bitboard& b : posiciones) incrementales.emplace_back(b);
+    medirLote("jugadaYFinNucleo() (como gato)", incrementales, N, [](const TableroIncremental& t) {
+        TableroIncremental copia = t;
+        return jugadaYFinNucleo(copia);
+    });
+    medirLote("cpuMedium()", posiciones, N / 4, [&ctx](const Bitboard& b) { return cpuMedium(b, ctx); });
+    printf("\n");
+
+    LotePosiciones lote;
+    for (const Bitboard& b : posiciones) lote.agregar(b);
+    for (NucleoSIMD nucleo : nucleosDisponibles())
+        medirEvaluarLote(nucleo, lote, static_cast<int>(N / static_cast<long long>(lote.size())));
+    printf("\n");
+
+    // Posiciones canónicas para la búsqueda
+    Bitboard vacio;
+    Bitboard centro;       // X al centro, juega O
+    centro.set(1, 1, 'X');
+    Bitboard esquina;      // X en esquina, juega O
+    esquina.set(0, 0, 'X');
+    Bitboard medioJuego;   // X: esquina y centro, O: esquina opuesta; juega X
+    medioJuego.set(0, 0, 'X');
+    medioJuego.set(1, 1, 'X');
+    medioJuego.set(2, 2, 'O');
+
+    medirMinimax("minimax() vacio, tabla fria", vacio, 200 * escala, true);
+    medirMinimax("minimax() vacio, tabla caliente", vacio, 20000 * escala, false);
+    medirMinimax("minimax() centro, tabla fria", centro, 500 * escala, true);
+    medirMinimax("minimax() esquina, tabla fria", esquina, 500 * escala, true);
+    medirMinimax("minimax() medio juego, tabla fria", medioJuego, 5000 * escala, true);
+    printf("\n");
+
+    medirMotorNxN<7, 4>("MotorNxN<7,4> partida", std::chrono::milliseconds(90));
+    PoolHilos pool;
+    std::string conPool = "MotorNxN<7,4> partida, " + std::to_string(pool.tamano()) + " hilos";
+    medirMotorNxN<7, 4>(conPool.c_str(), std::chrono::milliseconds(90), &pool);
+    printf("\n");
+
+    medirMCTS("MCTS vacio, 1 hilo", 200000 * escala, 1);
+    medirMCTS("MCTS vacio, todos los nucleos", 200000 * escala, 0);
+    return 0;
+}
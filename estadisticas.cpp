@@ -0,0 +1,158 @@
+// estadisticas.cpp
+// Analiza un registro de partidas (gato --registro, RegistroPartidas.hpp):
+// resultados y duración media por modo y dificultad, aperturas más jugadas
+// y las posiciones donde cpuMedium() deja escapar la partida según la
+// tabla de juego perfecto.
+//
+// El archivo se proyecta en memoria y se reparte en tramos que los hilos
+// toman con un contador atómico. Cada hilo acumula en sus propias
+// estadísticas, sin compartir nada, y se suman al final.
+//
+// Uso: estadisticas [archivo] [hilos]   (por defecto partidas.gato)
+#include "RegistroPartidas.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr std::size_t TAMANO_TRAMO = 1 << 16;
+constexpr int MODOS = 5;          // las cuatro dificultades y 1 vs 1
+constexpr int MODO_1VS1 = 4;
+
+// alineada a una línea de caché: los hilos no escriben en la misma
+struct alignas(64) EstadisticasHilo {
+    long long partidas[MODOS] = {};
+    long long ganaX[MODOS] = {};
+    long long ganaO[MODOS] = {};
+    long long jugadas[MODOS] = {};
+    long long aperturas[9][9] = {};   // primera jugada de X, respuesta de O
+    long long perdidasMedio = 0;
+    std::vector<std::uint32_t> erroresMedio = std::vector<std::uint32_t>(CODIGOS_TABLERO, 0);
+
+    void sumar(const EstadisticasHilo& otra) {
+        for (int m = 0; m < MODOS; m++) {
+            partidas[m] += otra.partidas[m];
+            ganaX[m] += otra.ganaX[m];
+            ganaO[m] += otra.ganaO[m];
+            jugadas[m] += otra.jugadas[m];
+        }
+        for (int a = 0; a < 9; a++)
+            for (int b = 0; b < 9; b++) aperturas[a][b] += otra.aperturas[a][b];
+        perdidasMedio += otra.perdidasMedio;
+        for (int c = 0; c < CODIGOS_TABLERO; c++) erroresMedio[c] += otra.erroresMedio[c];
+    }
+};
+
+// La IA juega con O. Su error es la jugada que lleva una posición que no
+// perdía (valor >= 0 desde O) a una que pierde: solo O puede empeorar su valor.
+void buscarErrores(const RegistroPartida& r, EstadisticasHilo& e) {
+    TableroIncremental t;
+    for (int i = 0; i < r.cantidad; i++) {
+        Bitboard antes = t.b;
+        t.colocar(r.jugadas[i]);
+        if (i % 2 == 1 && valorPerfecto(antes) >= 0 && valorPerfecto(t.b) < 0)
+            e.erroresMedio[codigoTablero(antes)]++;
+    }
+}
+
+void analizar(const RegistroPartida& r, EstadisticasHilo& e) {
+    int modo = r.vsIA ? std::min(static_cast<int>(r.dificultad), MODO_1VS1 - 1) : MODO_1VS1;
+    e.partidas[modo]++;
+    e.jugadas[modo] += r.cantidad;
+    if (r.resultado == ResultadoPartida::GanaX) e.ganaX[modo]++;
+    else if (r.resultado == ResultadoPartida::GanaO) e.ganaO[modo]++;
+    if (r.cantidad >= 2) e.aperturas[r.jugadas[0]][r.jugadas[1]]++;
+
+    if (r.vsIA && r.dificultad == Difficulty::Medium && r.resultado == ResultadoPartida::GanaX) {
+        e.perdidasMedio++;
+        buscarErrores(r, e);
+    }
+}
+
+double porcentaje(long long parte, long long total) {
+    return (total > 0) ? 100.0 * parte / total : 0.0;
+}
+
+int main(int argc, char** argv) {
+    std::string ruta = (argc > 1) ? argv[1] : "partidas.gato";
+    int hilos = (argc > 2) ? std::max(1, std::atoi(argv[2]))
+                           : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    LectorRegistros lector;
+    if (!lector.abrir(ruta)) {
+        printf("No se pudo leer el registro %s\n", ruta.c_str());
+        return 1;
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::size_t tramos = (lector.size() + TAMANO_TRAMO - 1) / TAMANO_TRAMO;
+    std::atomic<std::size_t> siguiente{0};
+    std::vector<EstadisticasHilo> porHilo(hilos);
+    std::vector<std::thread> trabajadores;
+    for (int h = 0; h < hilos; h++) {
+        trabajadores.emplace_back([&, h] {
+            EstadisticasHilo& e = porHilo[h];
+            for (std::size_t t; (t = siguiente.fetch_add(1)) < tramos;) {
+                std::size_t hasta = std::min(lector.size(), (t + 1) * TAMANO_TRAMO);
+                for (std::size_t i = t * TAMANO_TRAMO; i < hasta; i++) analizar(lector[i], e);
+            }
+        });
+    }
+    for (auto& t : trabajadores) t.join();
+
+    EstadisticasHilo total;
+    for (const EstadisticasHilo& e : porHilo) total.sumar(e);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    printf("%zu partidas en %.3f s con %d hilos (%.1f M partidas/s)\n\n", lector.size(), segundos, hilos,
+           segundos > 0 ? lector.size() / segundos / 1e6 : 0.0);
+
+    // con IA: la IA juega con O, así que "gana O" es una victoria de la IA
+    static const char* NOMBRES[MODOS] = {"IA facil", "IA medio", "IA dificil", "IA mcts", "1 vs 1"};
+    printf("%-12s %12s %10s %10s %10s %10s\n", "Modo", "Partidas", "Gana X", "Empate", "Gana O", "Jugadas");
+    for (int m = 0; m < MODOS; m++) {
+        long long n = total.partidas[m];
+        if (n == 0) continue;
+        long long empates = n - total.ganaX[m] - total.ganaO[m];
+        printf("%-12s %12lld %9.2f%% %9.2f%% %9.2f%% %10.2f\n", NOMBRES[m], n, porcentaje(total.ganaX[m], n),
+               porcentaje(empates, n), porcentaje(total.ganaO[m], n), double(total.jugadas[m]) / n);
+    }
+
+    // aperturas: primera jugada de X y respuesta de O, de más a menos jugadas
+    long long conApertura = 0;
+    std::vector<int> aperturas;
+    for (int a = 0; a < 81; a++) {
+        conApertura += total.aperturas[a / 9][a % 9];
+        if (total.aperturas[a / 9][a % 9] > 0) aperturas.push_back(a);
+    }
+    std::sort(aperturas.begin(), aperturas.end(),
+              [&](int a, int b) { return total.aperturas[a / 9][a % 9] > total.aperturas[b / 9][b % 9]; });
+    printf("\nAperturas mas jugadas (casilla de X, casilla de O):\n");
+    for (std::size_t i = 0; i < aperturas.size() && i < 10; i++) {
+        int a = aperturas[i];
+        printf("  X %d, O %d: %12lld (%.2f%%)\n", a / 9, a % 9, total.aperturas[a / 9][a % 9],
+               porcentaje(total.aperturas[a / 9][a % 9], conApertura));
+    }
+
+    // posiciones donde cpuMedium pasa de no perder a perder
+    std::vector<int> errores;
+    for (int c = 0; c < CODIGOS_TABLERO; c++)
+        if (total.erroresMedio[c] > 0) errores.push_back(c);
+    std::sort(errores.begin(), errores.end(),
+              [&](int a, int b) { return total.erroresMedio[a] > total.erroresMedio[b]; });
+    printf("\nPartidas perdidas por la IA media: %lld\n", total.perdidasMedio);
+    if (!errores.empty()) printf("Posiciones donde pierde (tablero, veces, jugada perfecta):\n");
+    ContextoIA ctx(1);
+    for (std::size_t i = 0; i < errores.size() && i < 10; i++) {
+        Bitboard b = tableroDeCodigo(errores[i]);
+        char texto[10] = {};
+        for (int j = 0; j < 9; j++) texto[j] = (b.get(j / 3, j % 3) == ' ') ? '.' : b.get(j / 3, j % 3);
+        printf("  %s %10u   %d\n", texto, total.erroresMedio[errores[i]],
+               elegirMovimiento(b, Difficulty::Hard, ctx));
+    }
+    return 0;
+}
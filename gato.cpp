@@ -5,13 +5,30 @@
 #include <string>
 #include <cmath>
 #include <cstdint>
-#include <ctime>
+#include <bit>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+#include <chrono>
 #include "IA.hpp"
+#include "LoteDibujo.hpp"
+#include "Animacion.hpp"
+#include "RegistroPartidas.hpp"
 
 const int WINDOW_SIZE = 700;
 const int CELL_SIZE = 200;
 const int MARGIN = 50;
 const float TRANSITION_TIME = 0.5f;
+const float CPU_MIN_THINK_TIME = 0.5f;
+const float WIN_LINE_TIME = 0.8f;
+const float THINKING_DOTS_PERIOD = 1.f;
+// Redibujo por eventos: sin nada que animar el bucle duerme en waitEvent
+// hasta este plazo (más largo si la ventana no tiene el foco)
+const float IDLE_WAIT_TIME = 0.25f;
+const float UNFOCUSED_WAIT_TIME = 1.f;
+const unsigned ACTIVE_FPS = 60;
+const unsigned UNFOCUSED_FPS = 15;
 
 struct GameState {
     static const int Menu = 0;
@@ -122,14 +139,12 @@ struct AudioManager {
     }
 };
 
-std::array<std::array<char, 3>, 3> board;
+TableroIncremental board;
 char currentPlayer = 'X';
 bool gameOver = false;
-std::string winnerText = "";
+const char* winnerText = "";
 int currentState = GameState::Menu;
 WinLine winningLine;
-float lineAnimation = 0.f;
-sf::Clock animationClock;
 AudioManager audio;
 bool wasHovering = false;
 
@@ -137,71 +152,110 @@ bool wasHovering = false;
 bool vsIA = false;
 Difficulty cpuDifficulty = Difficulty::Medium;
 sf::Clock cpuMoveClock;
+// Tabla de transposición y demás estado de la IA que dura toda la sesión;
+// se declara antes que los futures para destruirse después de ellos
+ContextoPersistente cpuContext;
 bool waitingForCPU = false;
+std::future<int> cpuMoveFuture;
+// El future de std::async espera al destruirse a que la tarea termine: una
+// jugada que ya no sirve (partida reiniciada, se salió al menú) se guarda
+// aquí y se suelta cuando ya terminó, sin frenar el bucle de dibujo
+std::vector<std::future<int>> discardedMoves;
+
+// Pondering (opcional): mientras X decide, la IA calcula en segundo plano
+// su respuesta a cada jugada posible de X sobre ponderBoard con la
+// dificultad ponderDifficulty. Solo sirve si la partida sigue siendo esa.
+bool ponderEnabled = false;
+Bitboard ponderBoard;
+Difficulty ponderDifficulty = Difficulty::Medium;
+std::future<std::array<int, 9>> ponderFuture;
+// Los descartados se guardan igual que las jugadas en discardedMoves
+std::vector<std::future<std::array<int, 9>>> discardedPonders;
+
+// Animaciones: todas avanzan juntas con el tiempo del cuadro (advanceAnimations)
+RelojCuadros frameClock;
+Interpolacion lineAnimation;        // largo de la línea ganadora, de 0 a 1
+Interpolacion thinkingDots;         // ciclo de los puntos de "IA pensando"
+int shownState = GameState::Menu;   // pantalla que se está viendo
+
+// Transiciones entre pantallas: al cambiar, la pantalla anterior y la nueva
+// se dibujan una sola vez en texturas y durante TRANSITION_TIME cada cuadro
+// pinta solo esas dos texturas, fundidas o deslizándose, sin volver a armar
+// ninguna escena. Si no se pueden crear las texturas el cambio es directo.
+struct ScreenTransition {
+    std::unique_ptr<sf::RenderTexture> from;
+    std::unique_ptr<sf::RenderTexture> to;
+    bool unavailable = false;
+    bool slide = false;
+    float direction = 1.f;      // 1: la nueva entra por la derecha
+    Interpolacion progress;     // de 0 a 1
+};
+ScreenTransition transition;
 
-void resetBoard() {
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            board[i][j] = ' ';
-        }
+// Registro de partidas (opcional, con --registro): cada partida terminada se
+// agrega al archivo desde el hilo del escritor
+std::unique_ptr<EscritorRegistros> gameLog;
+RegistroPartida currentRecord;
+
+void advanceAnimations(float dt) {
+    lineAnimation.avanzar(dt);
+    thinkingDots.avanzar(dt);
+    transition.progress.avanzar(dt);
+}
+
+bool animationsActive() {
+    return lineAnimation.activa() || thinkingDots.activa() || transition.progress.activa();
+}
+
+// Olvida el pondering en curso sin esperarlo
+void discardPondering() {
+    if (ponderFuture.valid()) {
+        discardedPonders.push_back(std::move(ponderFuture));
     }
+    ponderFuture = {};
+    ponderBoard = Bitboard{};
+}
+
+// Olvida la jugada que la IA está calculando sin esperarla
+void discardCpuMove() {
+    if (cpuMoveFuture.valid()) {
+        discardedMoves.push_back(std::move(cpuMoveFuture));
+    }
+    cpuMoveFuture = {};
+    waitingForCPU = false;
+    thinkingDots.fijar(0.f);
+}
+
+void resetBoard() {
+    discardPondering();
+    discardCpuMove();
+    board = TableroIncremental{};
     currentPlayer = 'X';
     gameOver = false;
     winnerText = "";
     winningLine.exists = false;
-    lineAnimation = 0.f;
-    waitingForCPU = false;
+    lineAnimation.fijar(0.f);
+    currentRecord = RegistroPartida{};
 }
 
+// El tablero lleva la cuenta de cada línea al colocar, así que aquí no se
+// recorre nada: solo se lee el resultado de la última jugada
 bool checkWinner() {
-    for (int i = 0; i < 3; i++) {
-        if (board[i][0] != ' ' && board[i][0] == board[i][1] && board[i][1] == board[i][2]) {
-            winnerText = std::string("Gana ") + board[i][0] + "!";
-            winningLine.start = sf::Vector2f(MARGIN + CELL_SIZE * 0 + CELL_SIZE/2, MARGIN + CELL_SIZE * i + CELL_SIZE/2);
-            winningLine.end = sf::Vector2f(MARGIN + CELL_SIZE * 3 - CELL_SIZE/2, MARGIN + CELL_SIZE * i + CELL_SIZE/2);
-            winningLine.exists = true;
-            return true;
-        }
-    }
-    
-    for (int i = 0; i < 3; i++) {
-        if (board[0][i] != ' ' && board[0][i] == board[1][i] && board[1][i] == board[2][i]) {
-            winnerText = std::string("Gana ") + board[0][i] + "!";
-            winningLine.start = sf::Vector2f(MARGIN + CELL_SIZE * i + CELL_SIZE/2, MARGIN + CELL_SIZE * 0 + CELL_SIZE/2);
-            winningLine.end = sf::Vector2f(MARGIN + CELL_SIZE * i + CELL_SIZE/2, MARGIN + CELL_SIZE * 3 - CELL_SIZE/2);
-            winningLine.exists = true;
-            return true;
-        }
-    }
-
-    if (board[0][0] != ' ' && board[0][0] == board[1][1] && board[1][1] == board[2][2]) {
-        winnerText = std::string("Gana ") + board[0][0] + "!";
-        winningLine.start = sf::Vector2f(MARGIN + CELL_SIZE/2, MARGIN + CELL_SIZE/2);
-        winningLine.end = sf::Vector2f(MARGIN + CELL_SIZE * 3 - CELL_SIZE/2, MARGIN + CELL_SIZE * 3 - CELL_SIZE/2);
-        winningLine.exists = true;
-        return true;
-    }
-    
-    if (board[0][2] != ' ' && board[0][2] == board[1][1] && board[1][1] == board[2][0]) {
-        winnerText = std::string("Gana ") + board[0][2] + "!";
-        winningLine.start = sf::Vector2f(MARGIN + CELL_SIZE * 3 - CELL_SIZE/2, MARGIN + CELL_SIZE/2);
-        winningLine.end = sf::Vector2f(MARGIN + CELL_SIZE/2, MARGIN + CELL_SIZE * 3 - CELL_SIZE/2);
+    if (board.linea >= 0) {
+        std::uint16_t linea = LINEAS_GANADORAS[board.linea];
+
+        // extremos de la línea: bit más bajo y bit más alto de la máscara
+        int desde = std::countr_zero(linea);
+        int hasta = std::bit_width(linea) - 1;
+        winnerText = (board.ganador() == 'X') ? "Gana X!" : "Gana O!";
+        winningLine.start = sf::Vector2f(MARGIN + CELL_SIZE * (desde % 3) + CELL_SIZE/2, MARGIN + CELL_SIZE * (desde / 3) + CELL_SIZE/2);
+        winningLine.end = sf::Vector2f(MARGIN + CELL_SIZE * (hasta % 3) + CELL_SIZE/2, MARGIN + CELL_SIZE * (hasta / 3) + CELL_SIZE/2);
         winningLine.exists = true;
+        lineAnimation.iniciar(0.f, 1.f, WIN_LINE_TIME);
         return true;
     }
 
-    bool full = true;
-    for (const auto& row : board) {
-        for (char c : row) {
-            if (c == ' ') {
-                full = false;
-                break;
-            }
-        }
-        if (!full) break;
-    }
-
-    if (full) {
+    if (board.lleno()) {
         winnerText = "Empate!";
         return true;
     }
@@ -209,68 +263,86 @@ bool checkWinner() {
     return false;
 }
 
-void drawGame(sf::RenderWindow& window, const sf::Font& font) {
-    sf::RectangleShape boardBg(sf::Vector2f(CELL_SIZE * 3 + 10, CELL_SIZE * 3 + 10));
-    boardBg.setPosition({(float)(MARGIN - 5), (float)(MARGIN - 5)});
-    boardBg.setFillColor(sf::Color(220, 220, 220));
-    window.draw(boardBg);
+void logFinishedGame() {
+    if (!gameLog) return;
+    char winner = board.ganador();
+    currentRecord.resultado = (winner == 'X') ? ResultadoPartida::GanaX
+                            : (winner == 'O') ? ResultadoPartida::GanaO : ResultadoPartida::Empate;
+    currentRecord.vsIA = vsIA;
+    currentRecord.dificultad = cpuDifficulty;
+    gameLog->agregar(currentRecord);
+}
 
-    sf::RectangleShape boardMain(sf::Vector2f(CELL_SIZE * 3, CELL_SIZE * 3));
-    boardMain.setPosition({(float)MARGIN, (float)MARGIN});
-    boardMain.setFillColor(sf::Color(245, 245, 245));
-    window.draw(boardMain);
+// Tablero en modo retenido: fondo, rejilla y fichas con su sombra se arman
+// en arreglos de vértices solo cuando cambia el tablero, y los textos del
+// turno y del final solo cuando cambia lo que dicen. Cada cuadro dibuja lo
+// ya armado más la línea ganadora.
+void buildBoardScene(LoteDibujo& scene, const sf::Font& font) {
+    scene.limpiar();
+    scene.rectangulo({(float)(MARGIN - 5), (float)(MARGIN - 5)}, {CELL_SIZE * 3 + 10.f, CELL_SIZE * 3 + 10.f},
+                     sf::Color(220, 220, 220));
+    scene.rectangulo({(float)MARGIN, (float)MARGIN}, {CELL_SIZE * 3.f, CELL_SIZE * 3.f}, sf::Color(245, 245, 245));
 
-    sf::RectangleShape line;
-    line.setFillColor(sf::Color(100, 100, 120));
     for (int i = 1; i < 3; i++) {
-        line.setSize(sf::Vector2f(6, CELL_SIZE * 3));
-        line.setPosition({(float)(MARGIN + i * CELL_SIZE - 3), (float)MARGIN});
-        window.draw(line);
-        line.setSize(sf::Vector2f(CELL_SIZE * 3, 6));
-        line.setPosition({(float)MARGIN, (float)(MARGIN + i * CELL_SIZE - 3)});
-        window.draw(line);
+        scene.rectangulo({(float)(MARGIN + i * CELL_SIZE - 3), (float)MARGIN}, {6.f, CELL_SIZE * 3.f},
+                         sf::Color(100, 100, 120));
+        scene.rectangulo({(float)MARGIN, (float)(MARGIN + i * CELL_SIZE - 3)}, {CELL_SIZE * 3.f, 6.f},
+                         sf::Color(100, 100, 120));
     }
 
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
-            if (board[i][j] != ' ') {
-                sf::Text shadow(font);
-                shadow.setString(std::string(1, board[i][j]));
-                shadow.setCharacterSize(120);
-                shadow.setFillColor(sf::Color(0, 0, 0, 40));
-                shadow.setStyle(sf::Text::Bold);
-                
-                sf::FloatRect bounds = shadow.getLocalBounds();
+            char celda = board.get(i, j);
+            if (celda != ' ') {
+                const std::string symbol(1, celda);
+                sf::FloatRect bounds = LoteDibujo::medirTexto(font, symbol, 120, true);
                 float posX = MARGIN + j * CELL_SIZE + (CELL_SIZE - bounds.size.x) / 2.f - bounds.position.x;
                 float posY = MARGIN + i * CELL_SIZE + (CELL_SIZE - bounds.size.y) / 2.f - bounds.position.y - 15.f;
-                
-                shadow.setPosition({posX + 3, posY + 3});
-                window.draw(shadow);
 
-                sf::Text text(font);
-                text.setString(std::string(1, board[i][j]));
-                text.setCharacterSize(120);
-                text.setStyle(sf::Text::Bold);
-                
-                if (board[i][j] == 'X') {
-                    text.setFillColor(sf::Color(255, 80, 80));
-                } else {
-                    text.setFillColor(sf::Color(80, 150, 255));
-                }
-                
-                text.setPosition({posX, posY});
-                window.draw(text);
+                scene.texto(font, symbol, 120, true, {posX + 3, posY + 3}, sf::Color(0, 0, 0, 40));
+                scene.texto(font, symbol, 120, true, {posX, posY},
+                            celda == 'X' ? sf::Color(255, 80, 80) : sf::Color(80, 150, 255));
             }
         }
     }
+}
+
+void buildHudScene(LoteDibujo& scene, const sf::Font& font, const std::string& turnString) {
+    scene.limpiar();
+    if (!gameOver) {
+        sf::FloatRect bounds = LoteDibujo::medirTexto(font, turnString, 40, true);
+        scene.texto(font, turnString, 40, true, {(WINDOW_SIZE - bounds.size.x) / 2.f, 10.f},
+                    currentPlayer == 'X' ? sf::Color(255, 80, 80) : sf::Color(80, 150, 255));
+        return;
+    }
+
+    scene.rectangulo({0.f, WINDOW_SIZE - 150.f}, {(float)WINDOW_SIZE, 150.f}, sf::Color(0, 0, 0, 180));
+
+    sf::FloatRect bounds = LoteDibujo::medirTexto(font, winnerText, 55, true);
+    scene.texto(font, winnerText, 55, true, {(WINDOW_SIZE - bounds.size.x) / 2.f, WINDOW_SIZE - 120.f},
+                sf::Color(255, 215, 0));
+
+    const std::string instruction = "Clic para volver al menu";
+    bounds = LoteDibujo::medirTexto(font, instruction, 25, false);
+    scene.texto(font, instruction, 25, false, {(WINDOW_SIZE - bounds.size.x) / 2.f, WINDOW_SIZE - 50.f},
+                sf::Color(200, 200, 200));
+}
 
-    if (winningLine.exists && lineAnimation < 1.f) {
-        lineAnimation += 0.02f;
-        if (lineAnimation > 1.f) lineAnimation = 1.f;
+LoteDibujo boardScene;
+std::optional<Bitboard> boardSceneKey;   // tablero con el que se armó boardScene
+LoteDibujo hudScene;
+std::string hudSceneKey;
+
+void drawGame(sf::RenderTarget& target, const sf::Font& font) {
+    if (boardSceneKey != board.b) {
+        buildBoardScene(boardScene, font);
+        boardSceneKey = board.b;
     }
-    if (winningLine.exists && lineAnimation > 0.f) {
+    boardScene.dibujar(target);
+
+    if (winningLine.exists && lineAnimation.valor() > 0.f) {
         sf::Vector2f direction = winningLine.end - winningLine.start;
-        float length = std::hypot(direction.x, direction.y) * lineAnimation; 
+        float length = std::hypot(direction.x, direction.y) * lineAnimation.valor();
         float angle = std::atan2(direction.y, direction.x) * 180.f / 3.14159f;
         sf::RectangleShape winLine(sf::Vector2f(length, 12));
         winLine.setPosition(winningLine.start);
@@ -278,561 +350,350 @@ void drawGame(sf::RenderWindow& window, const sf::Font& font) {
         winLine.setFillColor(sf::Color(255, 215, 0));
         winLine.setOutlineThickness(2);
         winLine.setOutlineColor(sf::Color(200, 170, 0));
-        window.draw(winLine);
+        target.draw(winLine);
     }
 
-    if (!gameOver) {
-        sf::Text turnText(font);
-        if (waitingForCPU) {
-            turnText.setString("Turno: IA pensando...");
-        } else {
-            turnText.setString(std::string("Turno: ") + currentPlayer);
-        }
-        turnText.setCharacterSize(40);
-        turnText.setStyle(sf::Text::Bold);
-        turnText.setFillColor(currentPlayer == 'X' ? sf::Color(255, 80, 80) : sf::Color(80, 150, 255));
-        
-        sf::FloatRect bounds = turnText.getLocalBounds();
-        turnText.setPosition({(WINDOW_SIZE - bounds.size.x) / 2.f, 10.f});
-        window.draw(turnText);
+    // el texto del turno cambia con los puntos de "pensando"; la clave junta
+    // todo lo que se ve en el HUD
+    std::string hudKey;
+    if (gameOver) {
+        hudKey = std::string("fin:") + winnerText;
+    } else if (waitingForCPU) {
+        // puntos animados mientras la IA calcula en segundo plano
+        int dots = 1 + static_cast<int>(thinkingDots.valor() * 3.f) % 3;
+        hudKey = "Turno: IA pensando" + std::string(dots, '.');
+    } else {
+        hudKey = std::string("Turno: ") + currentPlayer;
     }
+    if (hudKey != hudSceneKey) {
+        buildHudScene(hudScene, font, hudKey);
+        hudSceneKey = hudKey;
+    }
+    hudScene.dibujar(target);
+}
 
-    if (gameOver) {
-        sf::RectangleShape overlay(sf::Vector2f(WINDOW_SIZE, 150));
-        overlay.setPosition({0.f, WINDOW_SIZE - 150.f});
-        overlay.setFillColor(sf::Color(0, 0, 0, 180));
-        window.draw(overlay);
-
-        sf::Text msg(font);
-        msg.setString(winnerText);
-        msg.setCharacterSize(55);
-        msg.setStyle(sf::Text::Bold);
-        msg.setFillColor(sf::Color(255, 215, 0));
-        
-        sf::FloatRect bounds = msg.getLocalBounds();
-        msg.setPosition({(WINDOW_SIZE - bounds.size.x) / 2.f, WINDOW_SIZE - 120.f});
-        window.draw(msg);
-
-        sf::Text instruction(font);
-        instruction.setString("Clic para volver al menu");
-        instruction.setCharacterSize(25);
-        instruction.setFillColor(sf::Color(200, 200, 200));
-        
-        bounds = instruction.getLocalBounds();
-        instruction.setPosition({(WINDOW_SIZE - bounds.size.x) / 2.f, WINDOW_SIZE - 50.f});
-        window.draw(instruction);
+// Menús en lote: cada pantalla se arma en un LoteDibujo (un arreglo de
+// rectángulos y uno de glifos por tamaño de letra) y se vuelve a armar solo
+// cuando cambia su clave: qué botón está bajo el mouse y, en audio, los
+// volúmenes y opciones. El resto de los cuadros dibuja lo ya armado.
+struct MenuScene {
+    LoteDibujo scene;
+    std::uint64_t key = ~std::uint64_t(0);   // ninguna clave real vale esto
+};
+MenuScene menuScenes[6];   // indexado por GameState
+
+// Devuelve true si hay que volver a armar la pantalla
+bool needsRebuild(MenuScene& cache, std::uint64_t key) {
+    if (cache.key == key) return false;
+    cache.key = key;
+    cache.scene.limpiar();
+    return true;
+}
+
+void updateHover(bool hovering) {
+    if (hovering && !wasHovering) {
+        audio.playHover();
     }
+    wasHovering = hovering;
 }
 
-void drawMenu(sf::RenderWindow& window, const sf::Font& font) {
-    for (int i = 0; i < WINDOW_SIZE; i++) {
-        sf::RectangleShape line(sf::Vector2f(WINDOW_SIZE, 1));
-        line.setPosition({0.f, static_cast<float>(i)});
-        float ratio = static_cast<float>(i) / WINDOW_SIZE;
-        std::uint8_t color = 230 - static_cast<std::uint8_t>(ratio * 50);
-        line.setFillColor(sf::Color(color, color, color + 10));
-        window.draw(line);
+bool isInside(sf::Vector2i mousePos, float x, float y, float w, float h) {
+    return mousePos.x >= x && mousePos.x <= x + w && mousePos.y >= y && mousePos.y <= y + h;
+}
+
+// Ancho en píxeles de las barras de volumen
+float musicFillWidth() {
+    return (audio.musicVolume / 100.f) * 300.f;
+}
+
+float sfxFillWidth() {
+    return (audio.sfxVolume / 100.f) * 300.f;
+}
+
+// Fondo degradado: antes eran 700 líneas de un píxel, ahora un rectángulo
+// con colores por vértice
+void addBackground(LoteDibujo& scene) {
+    scene.degradado({0.f, 0.f}, {(float)WINDOW_SIZE, (float)WINDOW_SIZE}, sf::Color(230, 230, 240),
+                    sf::Color(180, 180, 190));
+}
+
+void addCenteredText(LoteDibujo& scene, const sf::Font& font, const std::string& text, unsigned size, bool bold,
+                     float y, sf::Color color) {
+    sf::FloatRect bounds = LoteDibujo::medirTexto(font, text, size, bold);
+    scene.texto(font, text, size, bold, {(WINDOW_SIZE - bounds.size.x) / 2.f, y}, color);
+}
+
+// Botón con borde y etiqueta blanca centrada; con sombra desplazada 5 px
+void addButton(LoteDibujo& scene, const sf::Font& font, float x, float y, float w, float h, sf::Color fill,
+               float outline, sf::Color outlineColor, const std::string& label, unsigned size, bool shadow = true) {
+    if (shadow) {
+        scene.rectangulo({x + 5.f, y + 5.f}, {w, h}, sf::Color(0, 0, 0, 60));
     }
+    scene.rectangulo({x, y}, {w, h}, fill, outline, outlineColor);
 
-    sf::Text titleShadow(font);
-    titleShadow.setString("JUEGO DEL GATO");
-    titleShadow.setCharacterSize(75);
-    titleShadow.setStyle(sf::Text::Bold);
-    titleShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    sf::FloatRect titleBounds = titleShadow.getLocalBounds();
-    titleShadow.setPosition({(WINDOW_SIZE - titleBounds.size.x) / 2.f + 4, 84.f});
-    window.draw(titleShadow);
-
-    sf::Text title(font);
-    title.setString("JUEGO DEL GATO");
-    title.setCharacterSize(75);
-    title.setStyle(sf::Text::Bold);
-    title.setFillColor(sf::Color(60, 60, 80));
-    title.setPosition({(WINDOW_SIZE - titleBounds.size.x) / 2.f, 80.f});
-    window.draw(title);
-
-    sf::Text xDecor(font);
-    xDecor.setString("X");
-    xDecor.setCharacterSize(100);
-    xDecor.setStyle(sf::Text::Bold);
-    xDecor.setFillColor(sf::Color(255, 80, 80, 150));
-    xDecor.setPosition({80.f, 200.f});
-    xDecor.setRotation(sf::degrees(-15.f));
-    window.draw(xDecor);
-
-    sf::Text oDecor(font);
-    oDecor.setString("O");
-    oDecor.setCharacterSize(100);
-    oDecor.setStyle(sf::Text::Bold);
-    oDecor.setFillColor(sf::Color(80, 150, 255, 150));
-    oDecor.setPosition({520.f, 200.f});
-    oDecor.setRotation(sf::degrees(15.f));
-    window.draw(oDecor);
-
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-    
-    bool isHoveringPlay = (mousePos.x >= 200 && mousePos.x <= 500 && 
-                           mousePos.y >= 280 && mousePos.y <= 360);
-    sf::RectangleShape buttonShadow(sf::Vector2f(300, 80));
-    buttonShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    buttonShadow.setPosition({205.f, 285.f});
-    window.draw(buttonShadow);
-    sf::RectangleShape playButton(sf::Vector2f(300, 80));
-    playButton.setFillColor(isHoveringPlay ? sf::Color(70, 220, 70) : sf::Color(50, 200, 50));
-    playButton.setPosition({200.f, 280.f});
-    playButton.setOutlineThickness(4);
-    playButton.setOutlineColor(sf::Color(30, 150, 30));
-    window.draw(playButton);
-
-    sf::Text playText(font);
-    playText.setString("JUGAR");
-    playText.setCharacterSize(50);
-    playText.setStyle(sf::Text::Bold);
-    playText.setFillColor(sf::Color::White);
-    sf::FloatRect textBounds = playText.getLocalBounds();
-    playText.setPosition({
-        200.f + (300.f - textBounds.size.x) / 2.f - textBounds.position.x,
-        280.f + (80.f - textBounds.size.y) / 2.f - textBounds.position.y
-    });
-    window.draw(playText);
-
-    bool isHoveringSettings = (mousePos.x >= 200 && mousePos.x <= 500 && 
-                               mousePos.y >= 380 && mousePos.y <= 460);
-    sf::RectangleShape settingsShadow(sf::Vector2f(300, 80));
-    settingsShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    settingsShadow.setPosition({205.f, 385.f});
-    window.draw(settingsShadow);
-    sf::RectangleShape settingsButton(sf::Vector2f(300, 80));
-    settingsButton.setFillColor(isHoveringSettings ? sf::Color(100, 150, 220) : sf::Color(80, 130, 200));
-    settingsButton.setPosition({200.f, 380.f});
-    settingsButton.setOutlineThickness(4);
-    settingsButton.setOutlineColor(sf::Color(50, 90, 150));
-    window.draw(settingsButton);
-
-    sf::Text settingsText(font);
-    settingsText.setString("AUDIO");
-    settingsText.setCharacterSize(45);
-    settingsText.setStyle(sf::Text::Bold);
-    settingsText.setFillColor(sf::Color::White);
-    textBounds = settingsText.getLocalBounds();
-    settingsText.setPosition({
-        200.f + (300.f - textBounds.size.x) / 2.f - textBounds.position.x,
-        380.f + (80.f - textBounds.size.y) / 2.f - textBounds.position.y
-    });
-    window.draw(settingsText);
-
-    if ((isHoveringPlay || isHoveringSettings) && !wasHovering) {
-        audio.playHover();
+    sf::FloatRect bounds = LoteDibujo::medirTexto(font, label, size, true);
+    scene.texto(font, label, size, true,
+                {x + (w - bounds.size.x) / 2.f - bounds.position.x, y + (h - bounds.size.y) / 2.f - bounds.position.y},
+                sf::Color::White);
+}
+
+// Clave de lo que se ve en cada menú con el mouse en mousePos. Los 8 bits
+// bajos dicen qué botón está bajo el mouse; en audio, los de arriba llevan
+// el ancho de las barras en píxeles, el porcentaje escrito y las opciones.
+// El bucle principal la compara con la del último armado para saber si
+// mover el mouse o una barra cambió algo en pantalla, y con los bits bajos
+// decide el sonido de hover.
+constexpr std::uint64_t HOVER_BITS = 0xFF;
+
+std::uint64_t menuKey(int state, sf::Vector2i mousePos) {
+    if (state == GameState::Menu) {
+        return isInside(mousePos, 200, 280, 300, 80) | isInside(mousePos, 200, 380, 300, 80) << 1;
+    }
+    if (state == GameState::ModeSelect) {
+        return isInside(mousePos, 200, 220, 300, 80) | isInside(mousePos, 200, 330, 300, 80) << 1 |
+               isInside(mousePos, 250, 480, 200, 70) << 2;
+    }
+    if (state == GameState::DifficultySelect) {
+        return isInside(mousePos, 200, 170, 300, 70) | isInside(mousePos, 200, 250, 300, 70) << 1 |
+               isInside(mousePos, 200, 330, 300, 70) << 2 | isInside(mousePos, 200, 410, 300, 70) << 3 |
+               isInside(mousePos, 250, 510, 200, 70) << 4;
+    }
+    if (state == GameState::Settings) {
+        std::uint64_t key = isInside(mousePos, 500, 190, 100, 40) | isInside(mousePos, 500, 320, 100, 40) << 1 |
+                            isInside(mousePos, 500, 390, 100, 40) << 2 | isInside(mousePos, 250, 450, 200, 70) << 3;
+        key |= std::uint64_t(audio.musicMuted) << 8 | std::uint64_t(audio.sfxMuted) << 9 |
+               std::uint64_t(ponderEnabled) << 10;
+        key |= std::uint64_t(static_cast<int>(musicFillWidth())) << 16 |
+               std::uint64_t(static_cast<int>(sfxFillWidth())) << 25;
+        key |= std::uint64_t(static_cast<int>(audio.musicVolume)) << 34 |
+               std::uint64_t(static_cast<int>(audio.sfxVolume)) << 41;
+        return key;
     }
-    wasHovering = isHoveringPlay || isHoveringSettings;
-
-    sf::Text instructions(font);
-    instructions.setString("Clic derecho para volver al menu");
-    instructions.setCharacterSize(22);
-    instructions.setFillColor(sf::Color(100, 100, 100));
-    sf::FloatRect instBounds = instructions.getLocalBounds();
-    instructions.setPosition({(WINDOW_SIZE - instBounds.size.x) / 2.f, 550.f});
-    window.draw(instructions);
+    return 0;
+}
+
+// Una pantalla de menú cuya clave ya no es la del último armado
+bool menuChanged(int state, sf::Vector2i mousePos) {
+    return state != GameState::Game && state != GameState::GameOver &&
+           menuScenes[state].key != menuKey(state, mousePos);
 }
 
-void drawModeSelect(sf::RenderWindow& window, const sf::Font& font) {
-    for (int i = 0; i < WINDOW_SIZE; i++) {
-        sf::RectangleShape line(sf::Vector2f(WINDOW_SIZE, 1));
-        line.setPosition({0.f, static_cast<float>(i)});
-        float ratio = static_cast<float>(i) / WINDOW_SIZE;
-        std::uint8_t color = 230 - static_cast<std::uint8_t>(ratio * 50);
-        line.setFillColor(sf::Color(color, color, color + 10));
-        window.draw(line);
+void drawMenu(sf::RenderTarget& target, const sf::Font& font, sf::Vector2i mousePos) {
+    std::uint64_t key = menuKey(GameState::Menu, mousePos);
+    bool isHoveringPlay = key & 1;
+    bool isHoveringSettings = key & 2;
+
+    MenuScene& cache = menuScenes[GameState::Menu];
+    if (needsRebuild(cache, key)) {
+        LoteDibujo& scene = cache.scene;
+        addBackground(scene);
+
+        sf::FloatRect titleBounds = LoteDibujo::medirTexto(font, "JUEGO DEL GATO", 75, true);
+        scene.texto(font, "JUEGO DEL GATO", 75, true, {(WINDOW_SIZE - titleBounds.size.x) / 2.f + 4, 84.f},
+                    sf::Color(0, 0, 0, 60));
+        scene.texto(font, "JUEGO DEL GATO", 75, true, {(WINDOW_SIZE - titleBounds.size.x) / 2.f, 80.f},
+                    sf::Color(60, 60, 80));
+
+        scene.texto(font, "X", 100, true, {80.f, 200.f}, sf::Color(255, 80, 80, 150), sf::degrees(-15.f));
+        scene.texto(font, "O", 100, true, {520.f, 200.f}, sf::Color(80, 150, 255, 150), sf::degrees(15.f));
+
+        addButton(scene, font, 200, 280, 300, 80, isHoveringPlay ? sf::Color(70, 220, 70) : sf::Color(50, 200, 50),
+                  4, sf::Color(30, 150, 30), "JUGAR", 50);
+        addButton(scene, font, 200, 380, 300, 80,
+                  isHoveringSettings ? sf::Color(100, 150, 220) : sf::Color(80, 130, 200), 4, sf::Color(50, 90, 150),
+                  "AUDIO", 45);
+
+        addCenteredText(scene, font, "Clic derecho para volver al menu", 22, false, 550.f, sf::Color(100, 100, 100));
     }
+    cache.scene.dibujar(target);
+}
 
-    sf::Text title(font);
-    title.setString("SELECCIONA MODO");
-    title.setCharacterSize(60);
-    title.setStyle(sf::Text::Bold);
-    title.setFillColor(sf::Color(60, 60, 80));
-    sf::FloatRect titleBounds = title.getLocalBounds();
-    title.setPosition({(WINDOW_SIZE - titleBounds.size.x) / 2.f, 80.f});
-    window.draw(title);
+void drawModeSelect(sf::RenderTarget& target, const sf::Font& font, sf::Vector2i mousePos) {
+    std::uint64_t key = menuKey(GameState::ModeSelect, mousePos);
+    bool isHovering1v1 = key & 1;
+    bool isHoveringIA = key & 2;
+    bool isHoveringBack = key & 4;
+
+    MenuScene& cache = menuScenes[GameState::ModeSelect];
+    if (needsRebuild(cache, key)) {
+        LoteDibujo& scene = cache.scene;
+        addBackground(scene);
+        addCenteredText(scene, font, "SELECCIONA MODO", 60, true, 80.f, sf::Color(60, 60, 80));
+
+        addButton(scene, font, 200, 220, 300, 80, isHovering1v1 ? sf::Color(70, 220, 70) : sf::Color(50, 200, 50),
+                  4, sf::Color(30, 150, 30), "1 vs 1", 50);
+        addButton(scene, font, 200, 330, 300, 80, isHoveringIA ? sf::Color(220, 150, 70) : sf::Color(200, 130, 50),
+                  4, sf::Color(150, 90, 30), "vs IA", 50);
+        addButton(scene, font, 250, 480, 200, 70, isHoveringBack ? sf::Color(100, 150, 220) : sf::Color(80, 130, 200),
+                  3, sf::Color(50, 90, 150), "VOLVER", 40);
+    }
+    cache.scene.dibujar(target);
+}
 
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-    
-    // Botón 1 vs 1
-    bool isHovering1v1 = (mousePos.x >= 200 && mousePos.x <= 500 && 
-                          mousePos.y >= 220 && mousePos.y <= 300);
-    sf::RectangleShape button1v1Shadow(sf::Vector2f(300, 80));
-    button1v1Shadow.setFillColor(sf::Color(0, 0, 0, 60));
-    button1v1Shadow.setPosition({205.f, 225.f});
-    window.draw(button1v1Shadow);
-    sf::RectangleShape button1v1(sf::Vector2f(300, 80));
-    button1v1.setFillColor(isHovering1v1 ? sf::Color(70, 220, 70) : sf::Color(50, 200, 50));
-    button1v1.setPosition({200.f, 220.f});
-    button1v1.setOutlineThickness(4);
-    button1v1.setOutlineColor(sf::Color(30, 150, 30));
-    window.draw(button1v1);
-
-    sf::Text text1v1(font);
-    text1v1.setString("1 vs 1");
-    text1v1.setCharacterSize(50);
-    text1v1.setStyle(sf::Text::Bold);
-    text1v1.setFillColor(sf::Color::White);
-    sf::FloatRect textBounds = text1v1.getLocalBounds();
-    text1v1.setPosition({
-        200.f + (300.f - textBounds.size.x) / 2.f - textBounds.position.x,
-        220.f + (80.f - textBounds.size.y) / 2.f - textBounds.position.y
-    });
-    window.draw(text1v1);
-
-    // Botón vs IA
-    bool isHoveringIA = (mousePos.x >= 200 && mousePos.x <= 500 && 
-                         mousePos.y >= 330 && mousePos.y <= 410);
-    sf::RectangleShape buttonIAShadow(sf::Vector2f(300, 80));
-    buttonIAShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    buttonIAShadow.setPosition({205.f, 335.f});
-    window.draw(buttonIAShadow);
-    sf::RectangleShape buttonIA(sf::Vector2f(300, 80));
-    buttonIA.setFillColor(isHoveringIA ? sf::Color(220, 150, 70) : sf::Color(200, 130, 50));
-    buttonIA.setPosition({200.f, 330.f});
-    buttonIA.setOutlineThickness(4);
-    buttonIA.setOutlineColor(sf::Color(150, 90, 30));
-    window.draw(buttonIA);
-
-    sf::Text textIA(font);
-    textIA.setString("vs IA");
-    textIA.setCharacterSize(50);
-    textIA.setStyle(sf::Text::Bold);
-    textIA.setFillColor(sf::Color::White);
-    textBounds = textIA.getLocalBounds();
-    textIA.setPosition({
-        200.f + (300.f - textBounds.size.x) / 2.f - textBounds.position.x,
-        330.f + (80.f - textBounds.size.y) / 2.f - textBounds.position.y
-    });
-    window.draw(textIA);
-
-    // Botón Volver
-    bool isHoveringBack = (mousePos.x >= 250 && mousePos.x <= 450 && 
-                           mousePos.y >= 480 && mousePos.y <= 550);
-    sf::RectangleShape backShadow(sf::Vector2f(200, 70));
-    backShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    backShadow.setPosition({255.f, 485.f});
-    window.draw(backShadow);
-    sf::RectangleShape backButton(sf::Vector2f(200, 70));
-    backButton.setFillColor(isHoveringBack ? sf::Color(100, 150, 220) : sf::Color(80, 130, 200));
-    backButton.setPosition({250.f, 480.f});
-    backButton.setOutlineThickness(3);
-    backButton.setOutlineColor(sf::Color(50, 90, 150));
-    window.draw(backButton);
-
-    sf::Text backText(font);
-    backText.setString("VOLVER");
-    backText.setCharacterSize(40);
-    backText.setStyle(sf::Text::Bold);
-    backText.setFillColor(sf::Color::White);
-    sf::FloatRect backBounds = backText.getLocalBounds();
-    backText.setPosition({
-        250.f + (200.f - backBounds.size.x) / 2.f - backBounds.position.x,
-        480.f + (70.f - backBounds.size.y) / 2.f - backBounds.position.y
-    });
-    window.draw(backText);
-
-    if ((isHovering1v1 || isHoveringIA || isHoveringBack) && !wasHovering) {
-        audio.playHover();
+void drawDifficultySelect(sf::RenderTarget& target, const sf::Font& font, sf::Vector2i mousePos) {
+    std::uint64_t key = menuKey(GameState::DifficultySelect, mousePos);
+    bool isHoveringEasy = key & 1;
+    bool isHoveringMedium = key & 2;
+    bool isHoveringHard = key & 4;
+    bool isHoveringMCTS = key & 8;
+    bool isHoveringBack = key & 16;
+
+    MenuScene& cache = menuScenes[GameState::DifficultySelect];
+    if (needsRebuild(cache, key)) {
+        LoteDibujo& scene = cache.scene;
+        addBackground(scene);
+        addCenteredText(scene, font, "DIFICULTAD", 60, true, 80.f, sf::Color(60, 60, 80));
+
+        addButton(scene, font, 200, 170, 300, 70, isHoveringEasy ? sf::Color(120, 220, 120) : sf::Color(100, 200, 100),
+                  3, sf::Color(60, 160, 60), "FACIL", 45);
+        addButton(scene, font, 200, 250, 300, 70, isHoveringMedium ? sf::Color(240, 200, 80) : sf::Color(220, 180, 60),
+                  3, sf::Color(180, 140, 40), "MEDIO", 45);
+        addButton(scene, font, 200, 330, 300, 70, isHoveringHard ? sf::Color(240, 90, 90) : sf::Color(220, 70, 70),
+                  3, sf::Color(180, 40, 40), "DIFICIL", 45);
+        addButton(scene, font, 200, 410, 300, 70, isHoveringMCTS ? sf::Color(170, 110, 230) : sf::Color(150, 90, 210),
+                  3, sf::Color(110, 60, 170), "MCTS", 45);
+        addButton(scene, font, 250, 510, 200, 70, isHoveringBack ? sf::Color(100, 150, 220) : sf::Color(80, 130, 200),
+                  3, sf::Color(50, 90, 150), "VOLVER", 40);
     }
-    wasHovering = isHovering1v1 || isHoveringIA || isHoveringBack;
+    cache.scene.dibujar(target);
 }
 
-void drawDifficultySelect(sf::RenderWindow& window, const sf::Font& font) {
-    for (int i = 0; i < WINDOW_SIZE; i++) {
-        sf::RectangleShape line(sf::Vector2f(WINDOW_SIZE, 1));
-        line.setPosition({0.f, static_cast<float>(i)});
-        float ratio = static_cast<float>(i) / WINDOW_SIZE;
-        std::uint8_t color = 230 - static_cast<std::uint8_t>(ratio * 50);
-        line.setFillColor(sf::Color(color, color, color + 10));
-        window.draw(line);
+void drawSettings(sf::RenderTarget& target, const sf::Font& font, sf::Vector2i mousePos) {
+    std::uint64_t key = menuKey(GameState::Settings, mousePos);
+    bool isHoveringMusicMute = key & 1;
+    bool isHoveringSfxMute = key & 2;
+    bool isHoveringPonder = key & 4;
+    bool isHoveringBack = key & 8;
+
+    float musicFill = musicFillWidth();
+    float sfxFill = sfxFillWidth();
+    int musicPercent = static_cast<int>(audio.musicVolume);
+    int sfxPercent = static_cast<int>(audio.sfxVolume);
+
+    MenuScene& cache = menuScenes[GameState::Settings];
+    if (needsRebuild(cache, key)) {
+        LoteDibujo& scene = cache.scene;
+        addBackground(scene);
+        addCenteredText(scene, font, "CONFIGURACION DE AUDIO", 50, true, 50.f, sf::Color(60, 60, 80));
+
+        scene.texto(font, "Musica", 35, true, {100.f, 150.f}, sf::Color(60, 60, 80));
+        scene.rectangulo({100.f, 200.f}, {300.f, 20.f}, sf::Color(180, 180, 180), 2, sf::Color(100, 100, 100));
+        scene.rectangulo({100.f, 200.f}, {musicFill, 20.f},
+                         audio.musicMuted ? sf::Color(150, 150, 150) : sf::Color(80, 150, 255));
+        scene.texto(font, std::to_string(musicPercent) + "%", 28, false, {420.f, 193.f}, sf::Color(60, 60, 80));
+        addButton(scene, font, 500, 190, 100, 40, isHoveringMusicMute ? sf::Color(220, 80, 80) : sf::Color(200, 60, 60),
+                  2, sf::Color(150, 30, 30), audio.musicMuted ? "UNMUTE" : "MUTE", 25, false);
+
+        scene.texto(font, "Efectos de Sonido", 35, true, {100.f, 280.f}, sf::Color(60, 60, 80));
+        scene.rectangulo({100.f, 330.f}, {300.f, 20.f}, sf::Color(180, 180, 180), 2, sf::Color(100, 100, 100));
+        scene.rectangulo({100.f, 330.f}, {sfxFill, 20.f},
+                         audio.sfxMuted ? sf::Color(150, 150, 150) : sf::Color(255, 150, 80));
+        scene.texto(font, std::to_string(sfxPercent) + "%", 28, false, {420.f, 323.f}, sf::Color(60, 60, 80));
+        addButton(scene, font, 500, 320, 100, 40, isHoveringSfxMute ? sf::Color(220, 80, 80) : sf::Color(200, 60, 60),
+                  2, sf::Color(150, 30, 30), audio.sfxMuted ? "UNMUTE" : "MUTE", 25, false);
+
+        scene.texto(font, "IA piensa en tu turno", 28, true, {100.f, 392.f}, sf::Color(60, 60, 80));
+        if (ponderEnabled) {
+            addButton(scene, font, 500, 390, 100, 40, isHoveringPonder ? sf::Color(70, 220, 70) : sf::Color(50, 200, 50),
+                      2, sf::Color(30, 150, 30), "SI", 25, false);
+        } else {
+            addButton(scene, font, 500, 390, 100, 40,
+                      isHoveringPonder ? sf::Color(170, 170, 170) : sf::Color(150, 150, 150), 2,
+                      sf::Color(100, 100, 100), "NO", 25, false);
+        }
+
+        addButton(scene, font, 250, 450, 200, 70, isHoveringBack ? sf::Color(100, 150, 220) : sf::Color(80, 130, 200),
+                  3, sf::Color(50, 90, 150), "VOLVER", 40);
+
+        addCenteredText(scene, font, "Arrastra en las barras para ajustar el volumen", 20, false, 580.f,
+                        sf::Color(100, 100, 100));
     }
+    cache.scene.dibujar(target);
+}
 
-    sf::Text title(font);
-    title.setString("DIFICULTAD");
-    title.setCharacterSize(60);
-    title.setStyle(sf::Text::Bold);
-    title.setFillColor(sf::Color(60, 60, 80));
-    sf::FloatRect titleBounds = title.getLocalBounds();
-    title.setPosition({(WINDOW_SIZE - titleBounds.size.x) / 2.f, 80.f});
-    window.draw(title);
-
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-
-    // Botón Fácil
-    bool isHoveringEasy = (mousePos.x >= 200 && mousePos.x <= 500 && 
-                           mousePos.y >= 200 && mousePos.y <= 270);
-    sf::RectangleShape easyButtonShadow(sf::Vector2f(300, 70));
-    easyButtonShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    easyButtonShadow.setPosition({205.f, 205.f});
-    window.draw(easyButtonShadow);
-    sf::RectangleShape easyButton(sf::Vector2f(300, 70));
-    easyButton.setFillColor(isHoveringEasy ? sf::Color(120, 220, 120) : sf::Color(100, 200, 100));
-    easyButton.setPosition({200.f, 200.f});
-    easyButton.setOutlineThickness(3);
-    easyButton.setOutlineColor(sf::Color(60, 160, 60));
-    window.draw(easyButton);
-
-    sf::Text easyText(font);
-    easyText.setString("FACIL");
-    easyText.setCharacterSize(45);
-    easyText.setStyle(sf::Text::Bold);
-    easyText.setFillColor(sf::Color::White);
-    sf::FloatRect textBounds = easyText.getLocalBounds();
-    easyText.setPosition({
-        200.f + (300.f - textBounds.size.x) / 2.f - textBounds.position.x,
-        200.f + (70.f - textBounds.size.y) / 2.f - textBounds.position.y
-    });
-    window.draw(easyText);
-
-    // Botón Medio
-    bool isHoveringMedium = (mousePos.x >= 200 && mousePos.x <= 500 && 
-                             mousePos.y >= 290 && mousePos.y <= 360);
-    sf::RectangleShape mediumButtonShadow(sf::Vector2f(300, 70));
-    mediumButtonShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    mediumButtonShadow.setPosition({205.f, 295.f});
-    window.draw(mediumButtonShadow);
-    sf::RectangleShape mediumButton(sf::Vector2f(300, 70));
-    mediumButton.setFillColor(isHoveringMedium ? sf::Color(240, 200, 80) : sf::Color(220, 180, 60));
-    mediumButton.setPosition({200.f, 290.f});
-    mediumButton.setOutlineThickness(3);
-    mediumButton.setOutlineColor(sf::Color(180, 140, 40));
-    window.draw(mediumButton);
-
-    sf::Text mediumText(font);
-    mediumText.setString("MEDIO");
-    mediumText.setCharacterSize(45);
-    mediumText.setStyle(sf::Text::Bold);
-    mediumText.setFillColor(sf::Color::White);
-    textBounds = mediumText.getLocalBounds();
-    mediumText.setPosition({
-        200.f + (300.f - textBounds.size.x) / 2.f - textBounds.position.x,
-        290.f + (70.f - textBounds.size.y) / 2.f - textBounds.position.y
-    });
-    window.draw(mediumText);
-
-    // Botón Difícil
-    bool isHoveringHard = (mousePos.x >= 200 && mousePos.x <= 500 && 
-                           mousePos.y >= 380 && mousePos.y <= 450);
-    sf::RectangleShape hardButtonShadow(sf::Vector2f(300, 70));
-    hardButtonShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    hardButtonShadow.setPosition({205.f, 385.f});
-    window.draw(hardButtonShadow);
-    sf::RectangleShape hardButton(sf::Vector2f(300, 70));
-    hardButton.setFillColor(isHoveringHard ? sf::Color(240, 90, 90) : sf::Color(220, 70, 70));
-    hardButton.setPosition({200.f, 380.f});
-    hardButton.setOutlineThickness(3);
-    hardButton.setOutlineColor(sf::Color(180, 40, 40));
-    window.draw(hardButton);
-
-    sf::Text hardText(font);
-    hardText.setString("DIFICIL");
-    hardText.setCharacterSize(45);
-    hardText.setStyle(sf::Text::Bold);
-    hardText.setFillColor(sf::Color::White);
-    textBounds = hardText.getLocalBounds();
-    hardText.setPosition({
-        200.f + (300.f - textBounds.size.x) / 2.f - textBounds.position.x,
-        380.f + (70.f - textBounds.size.y) / 2.f - textBounds.position.y
-    });
-    window.draw(hardText);
-
-    // Botón Volver
-    bool isHoveringBack = (mousePos.x >= 250 && mousePos.x <= 450 && 
-                           mousePos.y >= 500 && mousePos.y <= 570);
-    sf::RectangleShape backShadow(sf::Vector2f(200, 70));
-    backShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    backShadow.setPosition({255.f, 505.f});
-    window.draw(backShadow);
-    sf::RectangleShape backButton(sf::Vector2f(200, 70));
-    backButton.setFillColor(isHoveringBack ? sf::Color(100, 150, 220) : sf::Color(80, 130, 200));
-    backButton.setPosition({250.f, 500.f});
-    backButton.setOutlineThickness(3);
-    backButton.setOutlineColor(sf::Color(50, 90, 150));
-    window.draw(backButton);
-
-    sf::Text backText(font);
-    backText.setString("VOLVER");
-    backText.setCharacterSize(40);
-    backText.setStyle(sf::Text::Bold);
-    backText.setFillColor(sf::Color::White);
-    sf::FloatRect backBounds = backText.getLocalBounds();
-    backText.setPosition({
-        250.f + (200.f - backBounds.size.x) / 2.f - backBounds.position.x,
-        500.f + (70.f - backBounds.size.y) / 2.f - backBounds.position.y
-    });
-    window.draw(backText);
-
-    if ((isHoveringEasy || isHoveringMedium || isHoveringHard || isHoveringBack) && !wasHovering) {
-        audio.playHover();
+void drawScreen(int state, sf::RenderTarget& target, const sf::Font& font, sf::Vector2i mousePos) {
+    target.clear(sf::Color::White);
+    if (state == GameState::Menu) {
+        drawMenu(target, font, mousePos);
+    } else if (state == GameState::ModeSelect) {
+        drawModeSelect(target, font, mousePos);
+    } else if (state == GameState::DifficultySelect) {
+        drawDifficultySelect(target, font, mousePos);
+    } else if (state == GameState::Game || state == GameState::GameOver) {
+        drawGame(target, font);
+    } else if (state == GameState::Settings) {
+        drawSettings(target, font, mousePos);
     }
-    wasHovering = isHoveringEasy || isHoveringMedium || isHoveringHard || isHoveringBack;
 }
 
-void drawSettings(sf::RenderWindow& window, const sf::Font& font) {
-    for (int i = 0; i < WINDOW_SIZE; i++) {
-        sf::RectangleShape line(sf::Vector2f(WINDOW_SIZE, 1));
-        line.setPosition({0.f, static_cast<float>(i)});
-        float ratio = static_cast<float>(i) / WINDOW_SIZE;
-        std::uint8_t color = 230 - static_cast<std::uint8_t>(ratio * 50);
-        line.setFillColor(sf::Color(color, color, color + 10));
-        window.draw(line);
+// Qué tan adentro del menú está cada pantalla: avanzar desliza hacia la
+// izquierda y volver, hacia la derecha
+int screenDepth(int state) {
+    if (state == GameState::Menu) return 0;
+    if (state == GameState::ModeSelect || state == GameState::Settings) return 1;
+    if (state == GameState::DifficultySelect) return 2;
+    return 3;
+}
+
+void startTransition(int fromState, int toState, const sf::Font& font, sf::Vector2i mousePos) {
+    if (transition.unavailable) return;
+    if (!transition.from) {
+        transition.from = std::make_unique<sf::RenderTexture>();
+        transition.to = std::make_unique<sf::RenderTexture>();
+        if (!transition.from->resize({WINDOW_SIZE, WINDOW_SIZE}) || !transition.to->resize({WINDOW_SIZE, WINDOW_SIZE})) {
+            printf("Sin texturas para las transiciones; los cambios de pantalla seran directos.\n");
+            transition.unavailable = true;
+            transition.from.reset();
+            transition.to.reset();
+            return;
+        }
     }
 
-    sf::Text title(font);
-    title.setString("CONFIGURACION DE AUDIO");
-    title.setCharacterSize(50);
-    title.setStyle(sf::Text::Bold);
-    title.setFillColor(sf::Color(60, 60, 80));
-    sf::FloatRect titleBounds = title.getLocalBounds();
-    title.setPosition({(WINDOW_SIZE - titleBounds.size.x) / 2.f, 50.f});
-    window.draw(title);
-
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-
-    sf::Text musicLabel(font);
-    musicLabel.setString("Musica");
-    musicLabel.setCharacterSize(35);
-    musicLabel.setStyle(sf::Text::Bold);
-    musicLabel.setFillColor(sf::Color(60, 60, 80));
-    musicLabel.setPosition({100.f, 150.f});
-    window.draw(musicLabel);
-
-    sf::RectangleShape musicBar(sf::Vector2f(300, 20));
-    musicBar.setPosition({100.f, 200.f});
-    musicBar.setFillColor(sf::Color(180, 180, 180));
-    musicBar.setOutlineThickness(2);
-    musicBar.setOutlineColor(sf::Color(100, 100, 100));
-    window.draw(musicBar);
-    float musicFill = (audio.musicVolume / 100.f) * 300.f;
-    sf::RectangleShape musicFillBar(sf::Vector2f(musicFill, 20));
-    musicFillBar.setPosition({100.f, 200.f});
-    musicFillBar.setFillColor(audio.musicMuted ? sf::Color(150, 150, 150) : sf::Color(80, 150, 255));
-    window.draw(musicFillBar);
-
-    sf::Text musicValue(font);
-    musicValue.setString(std::to_string(static_cast<int>(audio.musicVolume)) + "%");
-    musicValue.setCharacterSize(28);
-    musicValue.setFillColor(sf::Color(60, 60, 80));
-    musicValue.setPosition({420.f, 193.f});
-    window.draw(musicValue);
-
-    bool isHoveringMusicMute = (mousePos.x >= 500 && mousePos.x <= 600 && 
-                                mousePos.y >= 190 && mousePos.y <= 230);
-    sf::RectangleShape musicMuteBtn(sf::Vector2f(100, 40));
-    musicMuteBtn.setPosition({500.f, 190.f});
-    musicMuteBtn.setFillColor(isHoveringMusicMute ? sf::Color(220, 80, 80) : sf::Color(200, 60, 60));
-    musicMuteBtn.setOutlineThickness(2);
-    musicMuteBtn.setOutlineColor(sf::Color(150, 30, 30));
-    window.draw(musicMuteBtn);
-
-    sf::Text musicMuteText(font);
-    musicMuteText.setString(audio.musicMuted ? "UNMUTE" : "MUTE");
-    musicMuteText.setCharacterSize(25);
-    musicMuteText.setStyle(sf::Text::Bold);
-    musicMuteText.setFillColor(sf::Color::White);
-    sf::FloatRect muteBounds = musicMuteText.getLocalBounds();
-    musicMuteText.setPosition({
-        500.f + (100.f - muteBounds.size.x) / 2.f - muteBounds.position.x,
-        190.f + (40.f - muteBounds.size.y) / 2.f - muteBounds.position.y
-    });
-    window.draw(musicMuteText);
-
-    sf::Text sfxLabel(font);
-    sfxLabel.setString("Efectos de Sonido");
-    sfxLabel.setCharacterSize(35);
-    sfxLabel.setStyle(sf::Text::Bold);
-    sfxLabel.setFillColor(sf::Color(60, 60, 80));
-    sfxLabel.setPosition({100.f, 280.f});
-    window.draw(sfxLabel);
-
-    sf::RectangleShape sfxBar(sf::Vector2f(300, 20));
-    sfxBar.setPosition({100.f, 330.f});
-    sfxBar.setFillColor(sf::Color(180, 180, 180));
-    sfxBar.setOutlineThickness(2);
-    sfxBar.setOutlineColor(sf::Color(100, 100, 100));
-    window.draw(sfxBar);
-    float sfxFill = (audio.sfxVolume / 100.f) * 300.f;
-    sf::RectangleShape sfxFillBar(sf::Vector2f(sfxFill, 20));
-    sfxFillBar.setPosition({100.f, 330.f});
-    sfxFillBar.setFillColor(audio.sfxMuted ? sf::Color(150, 150, 150) : sf::Color(255, 150, 80));
-    window.draw(sfxFillBar);
-
-    sf::Text sfxValue(font);
-    sfxValue.setString(std::to_string(static_cast<int>(audio.sfxVolume)) + "%");
-    sfxValue.setCharacterSize(28);
-    sfxValue.setFillColor(sf::Color(60, 60, 80));
-    sfxValue.setPosition({420.f, 323.f});
-    window.draw(sfxValue);
-
-    bool isHoveringSfxMute = (mousePos.x >= 500 && mousePos.x <= 600 && 
-                             mousePos.y >= 320 && mousePos.y <= 360);
-    sf::RectangleShape sfxMuteBtn(sf::Vector2f(100, 40));
-    sfxMuteBtn.setPosition({500.f, 320.f});
-    sfxMuteBtn.setFillColor(isHoveringSfxMute ? sf::Color(220, 80, 80) : sf::Color(200, 60, 60));
-    sfxMuteBtn.setOutlineThickness(2);
-    sfxMuteBtn.setOutlineColor(sf::Color(150, 30, 30));
-    window.draw(sfxMuteBtn);
-
-    sf::Text sfxMuteText(font);
-    sfxMuteText.setString(audio.sfxMuted ? "UNMUTE" : "MUTE");
-    sfxMuteText.setCharacterSize(25);
-    sfxMuteText.setStyle(sf::Text::Bold);
-    sfxMuteText.setFillColor(sf::Color::White);
-    sf::FloatRect sfxMuteBounds = sfxMuteText.getLocalBounds();
-    sfxMuteText.setPosition({
-        500.f + (100.f - sfxMuteBounds.size.x) / 2.f - sfxMuteBounds.position.x,
-        320.f + (40.f - sfxMuteBounds.size.y) / 2.f - sfxMuteBounds.position.y
-    });
-    window.draw(sfxMuteText);
-
-    bool isHoveringBack = (mousePos.x >= 250 && mousePos.x <= 450 && 
-                           mousePos.y >= 450 && mousePos.y <= 520);
-    sf::RectangleShape backShadow(sf::Vector2f(200, 70));
-    backShadow.setFillColor(sf::Color(0, 0, 0, 60));
-    backShadow.setPosition({255.f, 455.f});
-    window.draw(backShadow);
-    sf::RectangleShape backButton(sf::Vector2f(200, 70));
-    backButton.setFillColor(isHoveringBack ? sf::Color(100, 150, 220) : sf::Color(80, 130, 200));
-    backButton.setPosition({250.f, 450.f});
-    backButton.setOutlineThickness(3);
-    backButton.setOutlineColor(sf::Color(50, 90, 150));
-    window.draw(backButton);
-
-    sf::Text backText(font);
-    backText.setString("VOLVER");
-    backText.setCharacterSize(40);
-    backText.setStyle(sf::Text::Bold);
-    backText.setFillColor(sf::Color::White);
-    sf::FloatRect backBounds = backText.getLocalBounds();
-    backText.setPosition({
-        250.f + (200.f - backBounds.size.x) / 2.f - backBounds.position.x,
-        450.f + (70.f - backBounds.size.y) / 2.f - backBounds.position.y
-    });
-    window.draw(backText);
-
-    if ((isHoveringMusicMute || isHoveringSfxMute || isHoveringBack) && !wasHovering) {
-        audio.playHover();
+    drawScreen(fromState, *transition.from, font, mousePos);
+    transition.from->display();
+    drawScreen(toState, *transition.to, font, mousePos);
+    transition.to->display();
+
+    // entre menús se desliza; al entrar o salir del juego, fundido
+    bool toGame = toState == GameState::Game || toState == GameState::GameOver;
+    bool fromGame = fromState == GameState::Game || fromState == GameState::GameOver;
+    transition.slide = !toGame && !fromGame;
+    transition.direction = (screenDepth(toState) >= screenDepth(fromState)) ? 1.f : -1.f;
+    transition.progress.iniciar(0.f, 1.f, TRANSITION_TIME, Curva::SalidaSuave);
+}
+
+void drawTransition(sf::RenderTarget& target) {
+    float t = transition.progress.valor();
+    sf::Sprite from(transition.from->getTexture());
+    sf::Sprite to(transition.to->getTexture());
+    if (transition.slide) {
+        from.setPosition({-transition.direction * t * WINDOW_SIZE, 0.f});
+        to.setPosition({transition.direction * (1.f - t) * WINDOW_SIZE, 0.f});
+    } else {
+        to.setColor(sf::Color(255, 255, 255, static_cast<std::uint8_t>(t * 255.f)));
     }
-    wasHovering = isHoveringMusicMute || isHoveringSfxMute || isHoveringBack;
-
-    sf::Text instructions(font);
-    instructions.setString("Arrastra en las barras para ajustar el volumen");
-    instructions.setCharacterSize(20);
-    instructions.setFillColor(sf::Color(100, 100, 100));
-    sf::FloatRect instBounds = instructions.getLocalBounds();
-    instructions.setPosition({(WINDOW_SIZE - instBounds.size.x) / 2.f, 580.f});
-    window.draw(instructions);
+    target.draw(from);
+    target.draw(to);
 }
 
-int main() {
-    srand(static_cast<unsigned>(time(0)));
-    
+int main(int argc, char** argv) {
+    // gato --registro [archivo]: guarda cada partida terminada
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--registro") {
+            std::string path = (i + 1 < argc) ? argv[++i] : "partidas.gato";
+            gameLog = std::make_unique<EscritorRegistros>(path);
+            if (gameLog->abierto()) {
+                printf("Registrando partidas en %s\n", path.c_str());
+            } else {
+                printf("No se pudo abrir el registro %s\n", path.c_str());
+                gameLog.reset();
+            }
+        }
+    }
+
     sf::RenderWindow window(sf::VideoMode({WINDOW_SIZE, WINDOW_SIZE}), "Juego del Gato");
-    window.setFramerateLimit(60);
-    
+    window.setFramerateLimit(ACTIVE_FPS);
+
     sf::Font font;
     if (!font.openFromFile("C:/Windows/Fonts/arial.ttf")) {
         if (!font.openFromFile("C:/Windows/Fonts/calibri.ttf") &&
@@ -856,23 +717,85 @@ int main() {
     bool isDraggingMusic = false;
     bool isDraggingSfx = false;
 
+    // Solo se dibuja cuando algo cambió (needsRedraw) o hay una animación en
+    // marcha; el resto del tiempo el bucle espera eventos sin gastar CPU
+    bool needsRedraw = true;
+    bool focused = true;
+
     while (window.isOpen()) {
         
+        // Pondering: lanzar la búsqueda especulativa durante el turno de X.
+        // Un resultado de otra posición o de otra dificultad se descarta sin
+        // bloquear el bucle esperándolo.
+        auto finished = [](const auto& future) {
+            return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        };
+        std::erase_if(discardedPonders, finished);
+        std::erase_if(discardedMoves, finished);
+        if (ponderEnabled && currentState == GameState::Game && !gameOver && vsIA && currentPlayer == 'X') {
+            if (ponderFuture.valid() && (!(ponderBoard == board.b) || ponderDifficulty != cpuDifficulty)) {
+                discardPondering();
+            }
+            if (!ponderFuture.valid()) {
+                ponderBoard = board.b;
+                ponderDifficulty = cpuDifficulty;
+                ponderFuture = std::async(std::launch::async, cpuPonderar, board.b, cpuDifficulty,
+                                          std::ref(cpuContext));
+            }
+        }
+
+        // Si se salió del juego mientras la IA pensaba, su jugada ya no sirve
+        if (waitingForCPU && currentState != GameState::Game) {
+            discardCpuMove();
+            needsRedraw = true;
+        }
+
         // Lógica de movimiento de CPU
         if (currentState == GameState::Game && !gameOver && vsIA && currentPlayer == 'O' && !waitingForCPU) {
             waitingForCPU = true;
             cpuMoveClock.restart();
+            thinkingDots.repetirCada(THINKING_DOTS_PERIOD);
+
+            // ¿Coincide el tablero con el del pondering más la jugada de X?
+            std::uint16_t humanMove = board.b.x & ~ponderBoard.x;
+            bool pondered = ponderFuture.valid() && ponderDifficulty == cpuDifficulty &&
+                            board.b.o == ponderBoard.o && (ponderBoard.x & ~board.b.x) == 0 &&
+                            std::popcount(humanMove) == 1;
+
+            if (pondered && ponderFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                // respuesta ya calculada: se usa sin lanzar otra búsqueda
+                std::promise<int> ready;
+                ready.set_value(ponderFuture.get()[std::countr_zero(humanMove)]);
+                cpuMoveFuture = ready.get_future();
+            } else if (pondered) {
+                // el pondering sigue en marcha: se espera su resultado en segundo plano
+                int cell = std::countr_zero(humanMove);
+                cpuMoveFuture = std::async(std::launch::async,
+                    [future = std::move(ponderFuture), cell]() mutable { return future.get()[cell]; });
+            } else {
+                cpuMoveFuture = std::async(std::launch::async, cpuCalcularMovimiento, board.b, cpuDifficulty,
+                                           std::ref(cpuContext));
+            }
+            needsRedraw = true;
         }
 
-        if (waitingForCPU && cpuMoveClock.getElapsedTime().asSeconds() > 0.5f) {
-            cpuMakeMove(cpuDifficulty);
+        // La jugada se aplica cuando el hilo terminó y pasó el tiempo mínimo
+        // en pantalla, y solo sobre la partida en juego y en una casilla libre
+        if (waitingForCPU && currentState == GameState::Game && !gameOver && currentPlayer == 'O' &&
+            cpuMoveClock.getElapsedTime().asSeconds() > CPU_MIN_THINK_TIME &&
+            cpuMoveFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            int cell = cpuMoveFuture.get();
+            if (cell >= 0 && (board.b.libres() >> cell & 1)) {
+                board.colocar(cell);
+                currentRecord.agregarJugada(cell);
+            }
             audio.playMove();
             
             if (checkWinner()) {
                 gameOver = true;
                 currentState = GameState::GameOver;
-                animationClock.restart();
-                if (winnerText == "Empate!") {
+                logFinishedGame();
+                if (!winningLine.exists) {
                     audio.playDraw();
                 } else {
                     audio.playWin();
@@ -882,13 +805,45 @@ int main() {
             }
             
             waitingForCPU = false;
+            thinkingDots.fijar(0.f);
+            needsRedraw = true;
         }
-        
-        while (std::optional<sf::Event> event = window.pollEvent()) { 
-            
+
+        // Con animaciones (puntos de la IA, línea ganadora) se leen los
+        // eventos sin esperar y se dibuja cada cuadro; si no, se duerme hasta
+        // el próximo evento o el plazo. Arrastrando una barra de volumen el
+        // plazo es de un cuadro, y se dibuja solo si la barra cambió.
+        bool animating = animationsActive();
+        bool dragging = isDraggingMusic || isDraggingSfx;
+        sf::Time wait = sf::seconds(dragging ? 1.f / ACTIVE_FPS : focused ? IDLE_WAIT_TIME : UNFOCUSED_WAIT_TIME);
+        std::optional<sf::Event> event = animating ? window.pollEvent() : window.waitEvent(wait);
+
+        // El tiempo se toma después de esperar: lo que empiece con estos
+        // eventos arranca desde cero en el cuadro siguiente. Se dibuja
+        // también el cuadro en que una animación termina.
+        if (animationsActive()) {
+            needsRedraw = true;
+        }
+        advanceAnimations(frameClock.tick());
+
+        for (; event; event = window.pollEvent()) {
+            // mover el mouse solo importa si cambia el hover de un menú: eso
+            // se compara con su clave después de leer los eventos
+            if (!event->is<sf::Event::MouseMoved>()) {
+                needsRedraw = true;
+            }
+
             if (event->is<sf::Event::Closed>()) {
                 window.close();
             }
+
+            if (event->is<sf::Event::FocusLost>()) {
+                focused = false;
+                window.setFramerateLimit(UNFOCUSED_FPS);
+            } else if (event->is<sf::Event::FocusGained>()) {
+                focused = true;
+                window.setFramerateLimit(ACTIVE_FPS);
+            }
             
             const auto* mousePressed = event->getIf<sf::Event::MouseButtonPressed>();
             if (mousePressed) {
@@ -902,15 +857,16 @@ int main() {
                             int x = (mx - MARGIN) / CELL_SIZE;
                             int y = (my - MARGIN) / CELL_SIZE;
                             
-                            if (x >= 0 && x < 3 && y >= 0 && y < 3 && board[y][x] == ' ') {
-                                board[y][x] = currentPlayer;
+                            if (x >= 0 && x < 3 && y >= 0 && y < 3 && board.get(y, x) == ' ') {
+                                board.colocar(y * 3 + x);
+                                currentRecord.agregarJugada(y * 3 + x);
                                 audio.playMove();
                                 
                                 if (checkWinner()) {
                                     gameOver = true;
                                     currentState = GameState::GameOver;
-                                    animationClock.restart();
-                                    if (winnerText == "Empate!") {
+                                    logFinishedGame();
+                                    if (!winningLine.exists) {
                                         audio.playDraw();
                                     } else {
                                         audio.playWin();
@@ -945,28 +901,35 @@ int main() {
                             currentState = GameState::Menu;
                         }
                     } else if (currentState == GameState::DifficultySelect) {
-                        if (mx >= 200 && mx <= 500 && my >= 200 && my <= 270) {
+                        if (mx >= 200 && mx <= 500 && my >= 170 && my <= 240) {
                             audio.playClick();
                             cpuDifficulty = Difficulty::Easy;
                             vsIA = true;
                             resetBoard();
                             currentState = GameState::Game;
                         }
-                        else if (mx >= 200 && mx <= 500 && my >= 290 && my <= 360) {
+                        else if (mx >= 200 && mx <= 500 && my >= 250 && my <= 320) {
                             audio.playClick();
                             cpuDifficulty = Difficulty::Medium;
                             vsIA = true;
                             resetBoard();
                             currentState = GameState::Game;
                         }
-                        else if (mx >= 200 && mx <= 500 && my >= 380 && my <= 450) {
+                        else if (mx >= 200 && mx <= 500 && my >= 330 && my <= 400) {
                             audio.playClick();
                             cpuDifficulty = Difficulty::Hard;
                             vsIA = true;
                             resetBoard();
                             currentState = GameState::Game;
                         }
-                        else if (mx >= 250 && mx <= 450 && my >= 500 && my <= 570) {
+                        else if (mx >= 200 && mx <= 500 && my >= 410 && my <= 480) {
+                            audio.playClick();
+                            cpuDifficulty = Difficulty::MCTS;
+                            vsIA = true;
+                            resetBoard();
+                            currentState = GameState::Game;
+                        }
+                        else if (mx >= 250 && mx <= 450 && my >= 510 && my <= 580) {
                             audio.playClick();
                             currentState = GameState::ModeSelect;
                         }
@@ -986,6 +949,10 @@ int main() {
                             audio.playClick(); 
                             audio.toggleSfxMute();
                         }
+                        else if (mx >= 500 && mx <= 600 && my >= 390 && my <= 430) {
+                            audio.playClick();
+                            ponderEnabled = !ponderEnabled;
+                        }
                         else if (mx >= 100 && mx <= 400 && my >= 200 && my <= 220) {
                             isDraggingMusic = true;
                         }
@@ -1032,22 +999,43 @@ int main() {
             }
         }
 
-        window.clear(sf::Color::White);
-
-        if (currentState == GameState::Menu) {
-            drawMenu(window, font);
-        } else if (currentState == GameState::ModeSelect) {
-            drawModeSelect(window, font);
-        } else if (currentState == GameState::DifficultySelect) {
-            drawDifficultySelect(window, font);
-        } else if (currentState == GameState::Game || currentState == GameState::GameOver) {
-            drawGame(window, font);
-        } else if (currentState == GameState::Settings) {
-            drawSettings(window, font);
+        // Al pasar a otra pantalla empieza la transición; el tablero y el
+        // final de la partida son la misma pantalla
+        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+        bool inGameBefore = shownState == GameState::Game || shownState == GameState::GameOver;
+        bool inGameNow = currentState == GameState::Game || currentState == GameState::GameOver;
+        if (currentState != shownState) {
+            if (!(inGameBefore && inGameNow)) {
+                startTransition(shownState, currentState, font, mousePos);
+            }
+            shownState = currentState;
         }
-        
+
+        // El sonido de hover sale de aquí y no de las funciones de dibujo:
+        // armar las dos pantallas de una transición no debe sonar
+        if (!transition.progress.activa()) {
+            updateHover((menuKey(currentState, mousePos) & HOVER_BITS) != 0);
+            if (menuChanged(currentState, mousePos)) needsRedraw = true;
+        }
+
+        if (!needsRedraw && !animating) {
+            continue;
+        }
+        needsRedraw = false;
+
+        if (transition.progress.activa()) {
+            window.clear(sf::Color::White);
+            drawTransition(window);
+        } else {
+            drawScreen(currentState, window, font, mousePos);
+        }
+
         window.display();
     }
-    
+
+    // las texturas se liberan mientras el contexto de la ventana sigue vivo
+    transition.from.reset();
+    transition.to.reset();
+    gameLog.reset();   // escribe lo pendiente antes de salir
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+// simulador.cpp
+// Simulador sin interfaz: juega N partidas entre dos dificultades usando
+// todos los núcleos y reporta resultados, partidas por segundo y latencia
+// por jugada.
+//
+// Uso: simulador [partidas] [dificultadX] [dificultadO] [hilos] [semilla]
+//   dificultad: facil | medio | dificil | mcts
+#include "IA.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Histograma de latencias de tamaño fijo: 16 cubetas por cada potencia de
+// dos de nanosegundos, así que un percentil sale con menos de 1/16 de error
+// relativo y la memoria no crece con el número de partidas.
+struct HistogramaLatencia {
+    static constexpr int SUBCUBETAS = 16;
+    static constexpr int POTENCIAS = 40;   // hasta 2^40 ns, unos 18 minutos por jugada
+    std::array<long long, SUBCUBETAS * POTENCIAS> cubetas{};
+    long long total = 0;
+    std::uint64_t maximoNs = 0;
+
+    static int cubeta(std::uint64_t ns) {
+        if (ns < SUBCUBETAS) return static_cast<int>(ns);
+        int e = std::bit_width(ns) - 1;   // >= 4
+        int sub = static_cast<int>(ns >> (e - 4)) & (SUBCUBETAS - 1);
+        return std::min((e - 3) * SUBCUBETAS + sub, SUBCUBETAS * POTENCIAS - 1);
+    }
+
+    // Punto medio de la cubeta, en nanosegundos
+    static double centro(int i) {
+        if (i < SUBCUBETAS) return i;
+        int e = i / SUBCUBETAS + 3;
+        double ancho = std::ldexp(1.0, e - 4);
+        return (SUBCUBETAS + i % SUBCUBETAS) * ancho + ancho / 2;
+    }
+
+    void agregar(std::uint64_t ns) {
+        cubetas[cubeta(ns)]++;
+        total++;
+        maximoNs = std::max(maximoNs, ns);
+    }
+
+    void sumar(const HistogramaLatencia& otro) {
+        for (size_t i = 0; i < cubetas.size(); i++) cubetas[i] += otro.cubetas[i];
+        total += otro.total;
+        maximoNs = std::max(maximoNs, otro.maximoNs);
+    }
+
+    // Percentil p (0..1) en microsegundos; el máximo es exacto
+    double percentilUs(double p) const {
+        if (total == 0) return 0;
+        if (p >= 1.0) return maximoNs * 1e-3;
+        long long k = static_cast<long long>(p * (total - 1));
+        long long acumulado = 0;
+        for (size_t i = 0; i < cubetas.size(); i++) {
+            acumulado += cubetas[i];
+            if (acumulado > k) return std::min(centro(static_cast<int>(i)), double(maximoNs)) * 1e-3;
+        }
+        return maximoNs * 1e-3;
+    }
+};
+
+struct ResultadosHilo {
+    long long ganaX = 0;
+    long long ganaO = 0;
+    long long empates = 0;
+    HistogramaLatencia latencias;   // una muestra por jugada
+};
+
+bool leerDificultad(const std::string& nombre, Difficulty& diff) {
+    if (nombre == "facil") diff = Difficulty::Easy;
+    else if (nombre == "medio") diff = Difficulty::Medium;
+    else if (nombre == "dificil") diff = Difficulty::Hard;
+    else if (nombre == "mcts") diff = Difficulty::MCTS;
+    else return false;
+    return true;
+}
+
+const char* nombreDificultad(Difficulty diff) {
+    switch (diff) {
+        case Difficulty::Easy: return "facil";
+        case Difficulty::Medium: return "medio";
+        case Difficulty::Hard: return "dificil";
+        case Difficulty::MCTS: return "mcts";
+    }
+    return "?";
+}
+
+// Cada hilo juega las partidas hilo, hilo + hilos, ... con sus propios
+// contextos, sembrados a partir de la semilla global y del número de hilo.
+void jugarPartidas(int hilo, int hilos, long long partidas, Difficulty difX, Difficulty difO,
+                   std::uint32_t semilla, ResultadosHilo& res) {
+    ContextoIA ctxX(semilla + 2 * hilo);
+    ContextoIA ctxO(semilla + 2 * hilo + 1);
+    // el simulador ya reparte las partidas entre núcleos: MCTS usa un solo hilo
+    ctxX.mcts.hilos = 1;
+    ctxO.mcts.hilos = 1;
+
+    for (long long p = hilo; p < partidas; p += hilos) {
+        Bitboard b;
+        while (true) {
+            bool turnoX = (b.turno() == 'X');
+            auto inicio = std::chrono::steady_clock::now();
+            int casilla = turnoX ? elegirMovimiento(b, difX, ctxX) : elegirMovimiento(b, difO, ctxO);
+            auto fin = std::chrono::steady_clock::now();
+            res.latencias.agregar(std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio).count());
+
+            b.set(casilla / 3, casilla % 3, turnoX ? 'X' : 'O');
+            if (tieneLinea(b.x)) { res.ganaX++; break; }
+            if (tieneLinea(b.o)) { res.ganaO++; break; }
+            if (b.ocupadas() == TABLERO_COMPLETO) { res.empates++; break; }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    long long partidas = 100000;
+    Difficulty difX = Difficulty::Medium;
+    Difficulty difO = Difficulty::Hard;
+    int hilos = std::max(1u, std::thread::hardware_concurrency());
+    std::uint32_t semilla = 12345;
+
+    if (argc > 1) partidas = std::atoll(argv[1]);
+    if ((argc > 2 && !leerDificultad(argv[2], difX)) || (argc > 3 && !leerDificultad(argv[3], difO))) {
+        printf("Dificultad invalida. Usa: facil, medio, dificil o mcts\n");
+        return 1;
+    }
+    if (argc > 4) hilos = std::max(1, std::atoi(argv[4]));
+    if (argc > 5) semilla = static_cast<std::uint32_t>(std::strtoul(argv[5], nullptr, 10));
+    if (partidas <= 0) {
+        printf("Uso: simulador [partidas] [dificultadX] [dificultadO] [hilos] [semilla]\n");
+        return 1;
+    }
+
+    std::vector<ResultadosHilo> resultados(hilos);
+    std::vector<std::thread> trabajadores;
+
+    auto inicio = std::chrono::steady_clock::now();
+    for (int h = 0; h < hilos; h++)
+        trabajadores.emplace_back(jugarPartidas, h, hilos, partidas, difX, difO, semilla, std::ref(resultados[h]));
+    for (auto& t : trabajadores) t.join();
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    ResultadosHilo total;
+    for (auto& r : resultados) {
+        total.ganaX += r.ganaX;
+        total.ganaO += r.ganaO;
+        total.empates += r.empates;
+        total.latencias.sumar(r.latencias);
+    }
+
+    printf("%lld partidas: X (%s) vs O (%s), %d hilos, semilla %u\n",
+           partidas, nombreDificultad(difX), nombreDificultad(difO), hilos, semilla);
+    printf("  X gana:  %lld (%.2f%%)\n", total.ganaX, 100.0 * total.ganaX / partidas);
+    printf("  Empates: %lld (%.2f%%)\n", total.empates, 100.0 * total.empates / partidas);
+    printf("  O gana:  %lld (%.2f%%)\n", total.ganaO, 100.0 * total.ganaO / partidas);
+    printf("  Tiempo:  %.3f s, %.0f partidas/s\n", segundos, partidas / segundos);
+    printf("  Latencia por jugada (us): p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n",
+           total.latencias.percentilUs(0.50), total.latencias.percentilUs(0.90),
+           total.latencias.percentilUs(0.99), total.latencias.percentilUs(1.0));
+    return 0;
+}
@@ -0,0 +1,185 @@
+// solver.cpp
+// Resuelve por análisis retrógrado todas las posiciones de un tablero N x N
+// con K en línea y escribe la base que lee BaseDatos.hpp: un byte por
+// posición con el valor y la distancia al final, así que MotorNxN juega
+// perfecto (y gana por el camino más corto) sin buscar.
+//
+// Las posiciones se recorren por número de fichas, de la más llena a la
+// vacía: cada jugada agrega una ficha, así que al resolver un nivel todos
+// sus hijos ya están resueltos. Cada nivel se reparte entre hilos.
+//
+// Uso: solver [n] [k] [hilos] [archivo]   (n*n <= 16; por defecto 4 3)
+#include "BaseDatos.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Cada posición usa un byte: valor (2 bits) y distancia al final en jugadas
+// (6 bits). El archivo guarda la tabla tal cual.
+constexpr std::uint8_t valorDe(std::uint8_t b) { return b & 3; }
+constexpr std::uint8_t distanciaDe(std::uint8_t b) { return b >> 2; }
+constexpr std::uint8_t empaquetar(ValorBase v, int distancia) {
+    return static_cast<std::uint8_t>(static_cast<int>(v) | (distancia << 2));
+}
+
+struct Problema {
+    int n = 4;
+    int k = 3;
+    int celdas = 16;
+    std::vector<std::uint32_t> potencias;   // 3^i
+    std::vector<std::uint32_t> base3;       // máscara -> código con un 1 por bit
+    std::vector<std::uint32_t> lineas;      // todas las ventanas de K casillas
+
+    Problema(int n, int k) : n(n), k(k), celdas(n * n) {
+        potencias.resize(celdas);
+        potencias[0] = 1;
+        for (int i = 1; i < celdas; i++) potencias[i] = potencias[i - 1] * 3;
+
+        base3.resize(std::size_t(1) << celdas);
+        for (std::uint32_t m = 1; m < base3.size(); m++) {
+            int bajo = std::countr_zero(m);
+            base3[m] = base3[m & (m - 1)] + potencias[bajo];
+        }
+
+        const int direcciones[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                for (const auto& d : direcciones) {
+                    int rFin = r + d[0] * (k - 1), cFin = c + d[1] * (k - 1);
+                    if (rFin < 0 || rFin >= n || cFin < 0 || cFin >= n) continue;
+                    std::uint32_t linea = 0;
+                    for (int i = 0; i < k; i++) linea |= 1u << ((r + d[0] * i) * n + (c + d[1] * i));
+                    lineas.push_back(linea);
+                }
+            }
+        }
+    }
+
+    std::uint32_t posiciones() const { return potencias[celdas - 1] * 3; }
+    std::uint32_t codigo(std::uint32_t x, std::uint32_t o) const { return base3[x] + 2 * base3[o]; }
+
+    bool tieneLinea(std::uint32_t m) const {
+        for (std::uint32_t linea : lineas)
+            if ((m & linea) == linea) return true;
+        return false;
+    }
+};
+
+// Resuelve una posición con todos sus hijos ya resueltos
+std::uint8_t resolver(const Problema& p, const std::vector<std::uint8_t>& tabla,
+                      std::uint32_t x, std::uint32_t o) {
+    int nx = std::popcount(x), no = std::popcount(o);
+    bool juegaX = (nx == no);
+    bool lineaX = p.tieneLinea(x), lineaO = p.tieneLinea(o);
+
+    // ilegal: ambos con línea, o línea de quien no jugó último
+    if ((lineaX && lineaO) || (juegaX && lineaX) || (!juegaX && lineaO)) return empaquetar(ValorBase::Ilegal, 0);
+    if (lineaX || lineaO) return empaquetar(ValorBase::Pierde, 0);   // ganó quien acaba de jugar
+    std::uint32_t libres = ((1u << p.celdas) - 1) & ~(x | o);
+    if (libres == 0) return empaquetar(ValorBase::Empate, 0);
+
+    std::uint32_t base = p.codigo(x, o);
+    std::uint32_t factor = juegaX ? 1 : 2;
+    int ganaMin = 64, empate = -1, pierdeMax = 0;
+    for (std::uint32_t m = libres; m != 0; m &= m - 1) {
+        std::uint8_t hijo = tabla[base + factor * p.potencias[std::countr_zero(m)]];
+        int d = distanciaDe(hijo);
+        switch (static_cast<ValorBase>(valorDe(hijo))) {
+            case ValorBase::Pierde: ganaMin = std::min(ganaMin, d); break;   // el rival pierde
+            case ValorBase::Empate: empate = std::max(empate, d); break;
+            case ValorBase::Gana: pierdeMax = std::max(pierdeMax, d); break;
+            case ValorBase::Ilegal: break;
+        }
+    }
+    // ganar lo antes posible; si no, empatar; si no, perder lo más tarde posible
+    if (ganaMin < 64) return empaquetar(ValorBase::Gana, ganaMin + 1);
+    if (empate >= 0) return empaquetar(ValorBase::Empate, empate + 1);
+    return empaquetar(ValorBase::Pierde, pierdeMax + 1);
+}
+
+int main(int argc, char** argv) {
+    int n = (argc > 1) ? std::atoi(argv[1]) : 4;
+    int k = (argc > 2) ? std::atoi(argv[2]) : 3;
+    int hilos = (argc > 3) ? std::max(1, std::atoi(argv[3]))
+                           : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (n < 3 || n * n > 16 || k < 3 || k > n) {
+        printf("Uso: solver [n] [k] [hilos] [archivo]   (3 <= k <= n, n*n <= 16)\n");
+        return 1;
+    }
+    std::string ruta = (argc > 4) ? argv[4] : "base_" + std::to_string(n) + "x" + std::to_string(n) +
+                                              "_k" + std::to_string(k) + ".bin";
+
+    Problema p(n, k);
+    std::vector<std::uint8_t> tabla(p.posiciones(), empaquetar(ValorBase::Ilegal, 0));
+
+    // máscaras de X agrupadas por cantidad de fichas
+    std::vector<std::vector<std::uint32_t>> porFichas(p.celdas + 1);
+    for (std::uint32_t m = 0; m < (1u << p.celdas); m++) porFichas[std::popcount(m)].push_back(m);
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::atomic<long long> legales{0};
+    for (int fichas = p.celdas; fichas >= 0; fichas--) {
+        int nx = (fichas + 1) / 2, no = fichas / 2;
+        const auto& mascarasX = porFichas[nx];
+        std::atomic<std::size_t> siguiente{0};
+
+        // cada hilo toma máscaras de X y resuelve todas sus O posibles;
+        // posiciones distintas escriben bytes distintos de la tabla
+        auto trabajar = [&] {
+            long long propias = 0;
+            for (std::size_t i; (i = siguiente.fetch_add(1)) < mascarasX.size();) {
+                std::uint32_t x = mascarasX[i];
+                std::uint32_t libres = ((1u << p.celdas) - 1) & ~x;
+                // todos los subconjuntos de las casillas libres con `no` fichas
+                for (std::uint32_t o = libres;; o = (o - 1) & libres) {
+                    if (std::popcount(o) == no) {
+                        std::uint8_t r = resolver(p, tabla, x, o);
+                        tabla[p.codigo(x, o)] = r;
+                        if (valorDe(r) != 0) propias++;
+                    }
+                    if (o == 0) break;
+                }
+            }
+            legales += propias;
+        };
+        std::vector<std::thread> trabajadores;
+        for (int h = 0; h < hilos; h++) trabajadores.emplace_back(trabajar);
+        for (auto& t : trabajadores) t.join();
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    CabeceraBase cabecera;
+    std::memcpy(cabecera.magia, MAGIA_BASE, sizeof(MAGIA_BASE));
+    cabecera.n = static_cast<std::uint8_t>(n);
+    cabecera.k = static_cast<std::uint8_t>(k);
+    cabecera.bitsPorPosicion = 8;
+    cabecera.posiciones = p.posiciones();
+
+    FILE* f = std::fopen(ruta.c_str(), "wb");
+    if (f == nullptr) {
+        printf("No se pudo crear %s\n", ruta.c_str());
+        return 1;
+    }
+    bool ok = std::fwrite(&cabecera, sizeof(cabecera), 1, f) == 1 &&
+              std::fwrite(tabla.data(), 1, tabla.size(), f) == tabla.size();
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) {
+        printf("Error al escribir %s\n", ruta.c_str());
+        return 1;
+    }
+
+    static const char* NOMBRES[] = {"ilegal", "gana X", "empate", "gana O"};
+    std::uint8_t raiz = tabla[0];
+    printf("%dx%d, %d en linea: %lld posiciones legales en %.2f s con %d hilos\n",
+           n, n, k, legales.load(), segundos, hilos);
+    printf("  Tablero vacio: %s en %d jugadas\n", NOMBRES[valorDe(raiz)], distanciaDe(raiz));
+    printf("  Archivo: %s (%zu bytes)\n", ruta.c_str(), sizeof(cabecera) + tabla.size());
+    return 0;
+}